@@ -86,5 +86,6 @@ string(REPLACE ";" " " TARGET_CFLAGS "${_TARGET_CFLAGS}")
 string(REPLACE ";" " " TARGET_LDFLAGS "${_TARGET_LDFLAGS}")
 
 set(FILES_TARGET
+    ${PATH_APP}/mcal/${TARGET}/mcal_console
     ${PATH_APP}/mcal/${TARGET}/mcal_wdg_watchdog
 )
@@ -75,6 +75,17 @@ void app::benchmark::task_func()
 
   const bool result_is_ok = app::benchmark::run_pi_spigot();
 
+  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL)
+
+  const bool result_is_ok = (   app::benchmark::run_complex()
+                             && app::benchmark::run_crc()
+                             && app::benchmark::run_fast_math()
+                             && app::benchmark::run_filter()
+                             && app::benchmark::run_fixed_point()
+                             && app::benchmark::run_float()
+                             && app::benchmark::run_wide_integer()
+                             && app::benchmark::run_pi_spigot());
+
   #endif
 
   // Set the benchmark port pin level to low.
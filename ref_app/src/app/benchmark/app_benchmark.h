@@ -18,6 +18,11 @@
   #define APP_BENCHMARK_TYPE_WIDE_INTEGER        7
   #define APP_BENCHMARK_TYPE_PI_SPIGOT           8
 
+  // All of the benchmarks are compiled, for instance
+  // for the host benchmark runner in tools/benchmark.
+  #define APP_BENCHMARK_TYPE_ALL                 9
+
+  #if !defined(APP_BENCHMARK_TYPE)
   #define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_NONE
   //#define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_COMPLEX
   //#define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_CRC
@@ -27,26 +32,44 @@
   //#define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_FLOAT
   //#define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_WIDE_INTEGER
   //#define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_PI_SPIGOT
+  //#define APP_BENCHMARK_TYPE   APP_BENCHMARK_TYPE_ALL
+  #endif
 
   namespace app { namespace benchmark {
 
-  #if  (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_NONE)
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_COMPLEX)
+  // The parameters of the kernels below also name their variants
+  // in the host benchmark runner of tools/benchmark.
+
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_COMPLEX) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_complex();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_CRC)
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_CRC) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_crc();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FAST_MATH)
+  constexpr unsigned crc_data_size            =  9U;
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FAST_MATH) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_fast_math();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FILTER)
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FILTER) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_filter();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FIXED_POINT)
+  constexpr unsigned filter_order             = 17U;
+  constexpr unsigned filter_sample_digits     = 16U;
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FIXED_POINT) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_fixed_point();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FLOAT)
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FLOAT) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_float();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_WIDE_INTEGER)
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_WIDE_INTEGER) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_wide_integer();
-  #elif(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_PI_SPIGOT)
+  constexpr unsigned wide_integer_digits      = 256U;
+  constexpr unsigned wide_integer_limb_digits =  32U;
+  #endif
+  #if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_PI_SPIGOT) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
   bool run_pi_spigot();
+  constexpr unsigned pi_spigot_result_digits  = 21U;
+  constexpr unsigned pi_spigot_loop_digits    =  9U;
   #endif
 
   } } // namespace app:::benchmark
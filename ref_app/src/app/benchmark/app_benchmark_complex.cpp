@@ -7,7 +7,7 @@
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_COMPLEX)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_COMPLEX) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #define EXTENDED_COMPLEX_DISABLE_IOSTREAM
 
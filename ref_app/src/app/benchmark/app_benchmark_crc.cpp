@@ -9,14 +9,14 @@
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_CRC)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_CRC) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #include <math/checksums/crc/crc32.h>
 #include <mcal_memory/mcal_memory_progmem_array.h>
 
 bool app::benchmark::run_crc()
 {
-  static const mcal::memory::progmem::array<std::uint8_t, 9U> app_benchmark_crc_data MY_PROGMEM =
+  static const mcal::memory::progmem::array<std::uint8_t, app::benchmark::crc_data_size> app_benchmark_crc_data MY_PROGMEM =
   {{
     0x31U, 0x32U, 0x33U, 0x34U, 0x35U, 0x36U, 0x37U, 0x38U, 0x39U
   }};
@@ -8,7 +8,7 @@
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FAST_MATH)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FAST_MATH) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #define FAST_MATH_IMPLEMENT_SPECIALIZED_SQRT
 
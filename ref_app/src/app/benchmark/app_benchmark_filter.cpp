@@ -6,17 +6,21 @@
 //
 
 #include <cstdint>
+#include <limits>
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FILTER)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FILTER) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #include <math/filters/fir_order_n.h>
 
 namespace
 {
-  using filter_type = fir_order_n<17U, 64U, std::int16_t, std::int32_t>;
+  using filter_type = fir_order_n<app::benchmark::filter_order, 64U, std::int16_t, std::int32_t>;
   using sample_type = filter_type::sample_type;
+
+  static_assert((std::numeric_limits<sample_type>::digits + 1) == int(app::benchmark::filter_sample_digits),
+                "Error: Incorrect sample digit count for this example");
 }
 
 extern       filter_type f;
@@ -8,7 +8,7 @@
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FIXED_POINT)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_FIXED_POINT) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #define FIXED_POINT_DISABLE_IOSTREAM
 
@@ -11,7 +11,7 @@
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_PI_SPIGOT)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_PI_SPIGOT) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #include <math/constants/pi_spigot_state.h>
 #include <mcal_memory/mcal_memory_progmem_array.h>
@@ -33,7 +33,8 @@ namespace
     9U
   }};
 
-  using pi_spigot_type = math::constants::pi_spigot_state<21U, 9U>;
+  using pi_spigot_type = math::constants::pi_spigot_state<app::benchmark::pi_spigot_result_digits,
+                                                         app::benchmark::pi_spigot_loop_digits>;
 
   std::array<std::uint32_t, pi_spigot_type::get_input__static_size()> app_benchmark_pi_spigot_in_;
   std::array<std::uint8_t,  pi_spigot_type::get_output_static_size()> app_benchmark_pi_spigot_out;
@@ -7,7 +7,7 @@
 
 #include <app/benchmark/app_benchmark.h>
 
-#if(APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_WIDE_INTEGER)
+#if((APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_WIDE_INTEGER) || (APP_BENCHMARK_TYPE == APP_BENCHMARK_TYPE_ALL))
 
 #define WIDE_INTEGER_DISABLE_IOSTREAM
 
@@ -16,11 +16,14 @@
 namespace
 {
   using uint256_t =
-    wide_integer::generic_template::uintwide_t<256U, std::uint32_t>;
+    wide_integer::generic_template::uintwide_t<app::benchmark::wide_integer_digits, std::uint32_t>;
 
   static_assert(std::numeric_limits<uint256_t>::digits == 256,
                 "Error: Incorrect digit count for this example");
 
+  static_assert(std::numeric_limits<std::uint32_t>::digits == int(app::benchmark::wide_integer_limb_digits),
+                "Error: Incorrect limb digit count for this example");
+
   // Note: Some of the comments in this file use the Wolfram Language(TM).
   //
   // Create two pseudo-random 256-bit unsigned integers.
@@ -19,6 +19,14 @@
       inline void post_init() { }
 
       inline void nop() noexcept { asm volatile("nop"); }
+
+      inline bool wait_for_wakeup_is_supported() noexcept { return false; }
+
+      inline void wait_for_wakeup(const std::uint32_t wait_microseconds) noexcept { static_cast<void>(wait_microseconds); }
+
+      inline void wakeup() noexcept { }
+
+      inline void exit_on_signal() noexcept { }
     }
   }
 
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2014.
+//  Copyright Christopher Kormanyos 2014 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -14,7 +14,7 @@
   {
     namespace benchmark
     {
-      typedef mcal::port::port_pin benchmark_port_type;
+      typedef mcal::port::port_pin<0U> benchmark_port_type;
     }
   }
 
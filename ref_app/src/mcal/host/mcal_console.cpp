@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <mcal_console.h>
+#include <mcal_gpt.h>
+#include <util/utility/util_noncopyable.h>
+#include <util/utility/util_time.h>
+
+namespace
+{
+  typedef util::timer<mcal::gpt::value_type> mcal_console_timer_type;
+
+  // The ring buffer of the console lines. Any number of threads
+  // write lines, and the background thread (the one and only
+  // reader) prints them in the order of their claims.
+  // The claim and publication of a line follow os::deferred_queue.
+  class mcal_console_sink : private util::noncopyable
+  {
+  public:
+    static_assert((MCAL_CONSOLE_LINE_COUNT & (MCAL_CONSOLE_LINE_COUNT - 1U)) == 0U,
+                  "the number of console lines must be a power of two");
+
+    mcal_console_sink() : my_lines        (),
+                          my_count        (0U),
+                          my_tail         (0U),
+                          my_head         (0U),
+                          my_dropped_count(0U),
+                          my_start        (mcal_console_timer_type::get_mark()),
+                          my_exit_request (false),
+                          my_thread       (thread_function, this) { }
+
+    ~mcal_console_sink()
+    {
+      // Print the remaining lines at exit.
+      my_exit_request.store(true, std::memory_order_relaxed);
+
+      my_thread.join();
+    }
+
+    bool write(const char* pstr, const std::size_t length)
+    {
+      // Reserve a place in the ring buffer. Since the reserved
+      // places never exceed the capacity, the claimed line is free.
+      if(my_count.fetch_add(1U, std::memory_order_acquire) >= std::uint32_t(MCAL_CONSOLE_LINE_COUNT))
+      {
+        static_cast<void>(my_count.fetch_sub(1U, std::memory_order_relaxed));
+
+        static_cast<void>(my_dropped_count.fetch_add(1U, std::memory_order_relaxed));
+
+        return false;
+      }
+
+      const std::uint32_t sequence = my_tail.fetch_add(1U, std::memory_order_relaxed);
+
+      line_type& the_line = my_lines[sequence & line_mask];
+
+      the_line.timepoint = mcal_console_timer_type::get_mark();
+      the_line.length    = static_cast<std::uint8_t>((std::min)(length, mcal::console::line_length));
+
+      std::memcpy(the_line.text, pstr, the_line.length);
+
+      // Publish the line by writing its sequence number last.
+      the_line.sequence.store(std::uint32_t(sequence + 1U), std::memory_order_release);
+
+      return true;
+    }
+
+    std::uint32_t get_dropped_count() const
+    {
+      return my_dropped_count.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct line_type
+    {
+      mcal::gpt::value_type      timepoint;
+      std::atomic<std::uint32_t> sequence;
+      std::uint8_t               length;
+      char                       text[mcal::console::line_length];
+    };
+
+    static constexpr std::uint32_t line_mask = std::uint32_t(MCAL_CONSOLE_LINE_COUNT - 1U);
+
+    std::array<line_type, MCAL_CONSOLE_LINE_COUNT> my_lines;
+    std::atomic<std::uint32_t>                     my_count;
+    std::atomic<std::uint32_t>                     my_tail;
+    std::uint32_t                                  my_head;
+    std::atomic<std::uint32_t>                     my_dropped_count;
+    const mcal::gpt::value_type                    my_start;
+    std::atomic<bool>                              my_exit_request;
+    std::thread                                    my_thread;
+
+    std::size_t print_lines()
+    {
+      // Format the published lines into one batch (prefixed with
+      // the time since the start) and print them with one write.
+      static std::array<char, MCAL_CONSOLE_LINE_COUNT * (mcal::console::line_length + 24U)> batch;
+
+      std::size_t batch_length = 0U;
+      std::size_t line_count   = 0U;
+
+      for(;;)
+      {
+        line_type& the_line = my_lines[my_head & line_mask];
+
+        if(the_line.sequence.load(std::memory_order_acquire) != std::uint32_t(my_head + 1U))
+        {
+          break;
+        }
+
+        const mcal::gpt::value_type microseconds =
+          mcal::gpt::value_type(the_line.timepoint - my_start) / mcal_console_timer_type::microseconds(1U);
+
+        const int prefix_length =
+          std::snprintf(batch.data() + batch_length,
+                        batch.size() - batch_length,
+                        "[%6llu.%06llu] ",
+                        static_cast<unsigned long long>(microseconds / 1000000U),
+                        static_cast<unsigned long long>(microseconds % 1000000U));
+
+        batch_length += static_cast<std::size_t>(prefix_length);
+
+        std::memcpy(batch.data() + batch_length, the_line.text, the_line.length);
+
+        batch_length += the_line.length;
+
+        ++my_head;
+        ++line_count;
+
+        // Release the place of the line.
+        static_cast<void>(my_count.fetch_sub(1U, std::memory_order_release));
+
+        if(line_count == std::size_t(MCAL_CONSOLE_LINE_COUNT))
+        {
+          break;
+        }
+      }
+
+      if(batch_length != 0U)
+      {
+        static_cast<void>(std::fwrite(batch.data(), 1U, batch_length, stdout));
+        static_cast<void>(std::fflush(stdout));
+      }
+
+      return line_count;
+    }
+
+    static void thread_function(mcal_console_sink* sink)
+    {
+      for(;;)
+      {
+        const bool exit_is_requested = sink->my_exit_request.load(std::memory_order_relaxed);
+
+        if(sink->print_lines() == 0U)
+        {
+          if(exit_is_requested)
+          {
+            break;
+          }
+
+          std::this_thread::sleep_for(std::chrono::milliseconds(5U));
+        }
+      }
+    }
+  };
+
+  mcal_console_sink& mcal_console_the_sink()
+  {
+    static mcal_console_sink the_sink;
+
+    return the_sink;
+  }
+}
+
+bool mcal::console::write(const char* pstr, const std::size_t length)
+{
+  return mcal_console_the_sink().write(pstr, length);
+}
+
+std::uint32_t mcal::console::get_dropped_count()
+{
+  return mcal_console_the_sink().get_dropped_count();
+}
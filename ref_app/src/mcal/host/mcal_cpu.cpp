@@ -1,12 +1,142 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2019.
+//  Copyright Christopher Kormanyos 2019 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
 #include <mcal_cpu.h>
+#include <mcal_gpt.h>
+
+namespace
+{
+  std::mutex              mcal_cpu_wakeup_mutex;
+  std::condition_variable mcal_cpu_wakeup_condition;
+  std::atomic<bool>       mcal_cpu_wakeup_is_pending;
+  std::atomic<bool>       mcal_cpu_is_waiting;
+
+  std::atomic<bool>          mcal_cpu_exit_on_signal_is_installed;
+  volatile std::sig_atomic_t mcal_cpu_exit_is_requested;
+  int                        mcal_cpu_exit_pipe[2U];
+
+  void mcal_cpu_signal_handler(int signal_number)
+  {
+    // Only pass the signal to the exit thread here, which is
+    // async-signal-safe. If the exit has already been requested
+    // (and is stuck), terminate with the default action of the signal.
+    if(mcal_cpu_exit_is_requested != 0)
+    {
+      static_cast<void>(std::signal(signal_number, SIG_DFL));
+      static_cast<void>(std::raise(signal_number));
+    }
+    else
+    {
+      mcal_cpu_exit_is_requested = 1;
+
+      const unsigned char signal_byte = static_cast<unsigned char>(signal_number);
+
+      static_cast<void>(::write(mcal_cpu_exit_pipe[1U], &signal_byte, 1U));
+    }
+  }
+
+  void mcal_cpu_exit_thread_func()
+  {
+    // Wait for the signal and exit with the status of the shell
+    // for a terminating signal. The quick exit does not destroy
+    // the static objects, which other threads may still use.
+    unsigned char signal_byte;
+
+    ssize_t read_count;
+
+    do
+    {
+      read_count = ::read(mcal_cpu_exit_pipe[0U], &signal_byte, 1U);
+    }
+    while((read_count == -1) && (errno == EINTR));
+
+    if(read_count == 1)
+    {
+      std::quick_exit(128 + int(signal_byte));
+    }
+  }
+}
 
 void mcal::cpu::init()
 {
 }
+
+void mcal::cpu::exit_on_signal()
+{
+  if(mcal_cpu_exit_on_signal_is_installed.exchange(true) == false)
+  {
+    if(::pipe(mcal_cpu_exit_pipe) == 0)
+    {
+      std::thread(mcal_cpu_exit_thread_func).detach();
+
+      static_cast<void>(std::signal(SIGINT,  mcal_cpu_signal_handler));
+      static_cast<void>(std::signal(SIGTERM, mcal_cpu_signal_handler));
+    }
+  }
+}
+
+void mcal::cpu::wait_for_wakeup(const std::uint32_t wait_microseconds)
+{
+  #if (MCAL_GPT_VIRTUAL_TIME == 1)
+
+  // In the virtual time, the wait does not block. Instead, the system
+  // tick jumps over the wait time, which is the time until the next
+  // task deadline. A pending wakeup ends the wait immediately.
+  if(mcal_cpu_wakeup_is_pending.exchange(false) == false)
+  {
+    mcal::gpt::secure::advance_virtual_time(mcal::gpt::value_type(wait_microseconds));
+  }
+
+  #else
+
+  // Block the calling thread (which is the scheduler's idle task)
+  // until the wait time has elapsed or a wakeup has been requested.
+  // The monotonic steady clock is used for the timeout.
+  std::unique_lock<std::mutex> lock(mcal_cpu_wakeup_mutex);
+
+  mcal_cpu_is_waiting.store(true);
+
+  static_cast<void>(mcal_cpu_wakeup_condition.wait_for(lock,
+                                                       std::chrono::microseconds(wait_microseconds),
+                                                       []() -> bool
+                                                       {
+                                                         return mcal_cpu_wakeup_is_pending.load();
+                                                       }));
+
+  mcal_cpu_is_waiting.store(false);
+
+  mcal_cpu_wakeup_is_pending.store(false);
+
+  #endif
+}
+
+void mcal::cpu::wakeup()
+{
+  mcal_cpu_wakeup_is_pending.store(true);
+
+  // Take the lock and notify only if the idle task is actually waiting,
+  // so that setting an event from a busy scheduler costs no lock traffic.
+  if(mcal_cpu_is_waiting.load())
+  {
+    {
+      const std::lock_guard<std::mutex> lock(mcal_cpu_wakeup_mutex);
+    }
+
+    mcal_cpu_wakeup_condition.notify_one();
+  }
+}
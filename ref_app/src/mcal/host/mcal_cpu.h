@@ -21,6 +21,20 @@
 
   inline void nop() { }
 
+  inline bool wait_for_wakeup_is_supported() { return true; }
+
+  void wait_for_wakeup(const std::uint32_t wait_microseconds);
+
+  void wakeup();
+
+  // On the host, SIGINT and SIGTERM exit the application with
+  // std::quick_exit and the status 128 + signal, once something that
+  // is dumped at exit (the os trace or the port simulation) calls this.
+  // Then the handlers registered with std::at_quick_exit do not run in
+  // the signal handler, but in a thread which waits for the signal.
+  // A second signal terminates the application at once.
+  void exit_on_signal();
+
   } } // namespace mcal::cpu
 
 #endif // MCAL_CPU_2009_02_14_H_
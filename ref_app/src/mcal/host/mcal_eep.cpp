@@ -1,14 +1,393 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2018 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include <mcal_eep.h>
+#include <util/utility/util_noncopyable.h>
+
+namespace
+{
+  constexpr std::size_t mcal_eep_size       = std::size_t(MCAL_EEP_SIZE);
+  constexpr std::size_t mcal_eep_page_size  = std::size_t(MCAL_EEP_PAGE_SIZE);
+  constexpr std::size_t mcal_eep_page_count = mcal_eep_size / mcal_eep_page_size;
+
+  // The file holds the memory followed by the wear counters.
+  constexpr std::size_t mcal_eep_file_size = mcal_eep_size + (mcal_eep_page_count * sizeof(std::uint32_t));
+
+  static_assert((mcal_eep_page_size != 0U) && ((mcal_eep_size % mcal_eep_page_size) == 0U),
+                "the size of the host EEPROM must be a multiple of its page size");
+
+  // The file of the host EEPROM. On POSIX hosts, the file is mapped
+  // into memory, so that the programmed pages persist even if the
+  // program is terminated. Otherwise, the file is read into memory
+  // and each programmed page is written back to it.
+  class mcal_eep_file : private util::noncopyable
+  {
+  public:
+    mcal_eep_file() : my_memory(nullptr)
+    {
+      // Open (or create) the file (with the persistence).
+      #if (MCAL_EEP_PERSISTENT == 0)
+
+      #elif defined(__unix__) || defined(__APPLE__)
+
+      my_descriptor = ::open(MCAL_EEP_FILE_NAME, O_RDWR | O_CREAT, 0644);
+
+      const off_t file_size = ((my_descriptor >= 0) ? ::lseek(my_descriptor, 0, SEEK_END) : off_t(-1));
+
+      if((file_size >= 0) && (std::size_t(file_size) < mcal_eep_file_size))
+      {
+        // A new (or a smaller) file is extended to the size
+        // of the host EEPROM, and its new memory is erased.
+        const std::vector<std::uint8_t> erased(mcal_eep_file_size - std::size_t(file_size), UINT8_C(0xFF));
+
+        static_cast<void>(::pwrite(my_descriptor, erased.data(), erased.size(), file_size));
+      }
+
+      if(file_size >= 0)
+      {
+        void* p = ::mmap(nullptr, mcal_eep_file_size, PROT_READ | PROT_WRITE, MAP_SHARED, my_descriptor, 0);
+
+        my_memory = ((p != MAP_FAILED) ? static_cast<std::uint8_t*>(p) : nullptr);
+      }
+
+      #else
+
+      my_image.resize(mcal_eep_file_size, UINT8_C(0xFF));
+
+      std::FILE* file = std::fopen(MCAL_EEP_FILE_NAME, "rb");
+
+      if(file != nullptr)
+      {
+        static_cast<void>(std::fread(my_image.data(), 1U, my_image.size(), file));
+        static_cast<void>(std::fclose(file));
+      }
+
+      my_memory = my_image.data();
+
+      #endif
+    }
+
+    ~mcal_eep_file()
+    {
+      #if defined(__unix__) || defined(__APPLE__)
+      if(my_memory != nullptr)
+      {
+        static_cast<void>(::msync(my_memory, mcal_eep_file_size, MS_SYNC));
+        static_cast<void>(::munmap(my_memory, mcal_eep_file_size));
+      }
+
+      if(my_descriptor >= 0)
+      {
+        static_cast<void>(::close(my_descriptor));
+      }
+      #endif
+    }
+
+    bool is_open() const { return (my_memory != nullptr); }
+
+    std::uint8_t* memory() const { return my_memory; }
+
+    void sync_page(const std::size_t page_index)
+    {
+      #if defined(__unix__) || defined(__APPLE__)
+      // The kernel writes the mapped pages back to the file.
+      static_cast<void>(page_index);
+      #else
+      std::FILE* file = std::fopen(MCAL_EEP_FILE_NAME, "r+b");
+
+      if(file == nullptr)
+      {
+        file = std::fopen(MCAL_EEP_FILE_NAME, "w+b");
+      }
+
+      if(file != nullptr)
+      {
+        // Write the whole image if the file is new, otherwise
+        // the page and its wear counter.
+        const std::size_t counter_offset = mcal_eep_size + (page_index * sizeof(std::uint32_t));
+
+        static_cast<void>(std::fseek(file, 0L, SEEK_END));
+
+        if(std::size_t(std::ftell(file)) < mcal_eep_file_size)
+        {
+          static_cast<void>(std::fseek(file, 0L, SEEK_SET));
+          static_cast<void>(std::fwrite(my_memory, 1U, mcal_eep_file_size, file));
+        }
+        else
+        {
+          static_cast<void>(std::fseek(file, long(page_index * mcal_eep_page_size), SEEK_SET));
+          static_cast<void>(std::fwrite(my_memory + (page_index * mcal_eep_page_size), 1U, mcal_eep_page_size, file));
+          static_cast<void>(std::fseek(file, long(counter_offset), SEEK_SET));
+          static_cast<void>(std::fwrite(my_memory + counter_offset, 1U, sizeof(std::uint32_t), file));
+        }
+
+        static_cast<void>(std::fclose(file));
+      }
+      #endif
+    }
+
+  private:
+    std::uint8_t*             my_memory;
+    #if defined(__unix__) || defined(__APPLE__)
+    int                       my_descriptor = -1;
+    #else
+    std::vector<std::uint8_t> my_image;
+    #endif
+  };
+
+  // The host EEPROM device with its RAM image, its pending pages
+  // and the background thread that programs them. The thread blocks
+  // on the condition variable until a page becomes pending, and a
+  // flush blocks on it until no page is pending any more.
+  class mcal_eep_device : private util::noncopyable
+  {
+  public:
+    mcal_eep_device() : my_file           (),
+                        my_image          (),
+                        my_page_is_pending(),
+                        my_wear_count     (),
+                        my_pending_count  (0U),
+                        my_exit_request   (false)
+    {
+      for(std::size_t index = 0U; index < mcal_eep_size; ++index)
+      {
+        my_image[index].store(my_file.is_open() ? my_file.memory()[index] : UINT8_C(0xFF), std::memory_order_relaxed);
+      }
+
+      for(std::size_t page_index = 0U; page_index < mcal_eep_page_count; ++page_index)
+      {
+        my_page_is_pending[page_index].store(false, std::memory_order_relaxed);
+
+        std::uint32_t wear_count = 0U;
+
+        if(my_file.is_open())
+        {
+          std::memcpy(&wear_count, my_file.memory() + wear_count_offset(page_index), sizeof(std::uint32_t));
+        }
+
+        // An erased wear counter (of a new file) counts zero.
+        my_wear_count[page_index].store(((wear_count != UINT32_C(0xFFFFFFFF)) ? wear_count : 0U), std::memory_order_relaxed);
+      }
+
+      my_thread = std::thread(thread_function, this);
+    }
+
+    ~mcal_eep_device()
+    {
+      // Program the pending pages (without the page write time) at exit.
+      {
+        const std::lock_guard<std::mutex> lock(my_mutex);
+
+        my_exit_request.store(true, std::memory_order_relaxed);
+      }
+
+      my_condition.notify_all();
+
+      my_thread.join();
+    }
+
+    void write(const mcal::eep::address_type addr, const std::uint8_t data)
+    {
+      if(addr < mcal::eep::address_type(mcal_eep_size))
+      {
+        my_image[std::size_t(addr)].store(data, std::memory_order_relaxed);
+
+        bool page_is_newly_pending;
+
+        {
+          // Mark the page as pending and count it under the lock, which
+          // the thread takes to uncount a programmed page. So the thread
+          // never uncounts a page before it has been counted here.
+          const std::lock_guard<std::mutex> lock(my_mutex);
+
+          page_is_newly_pending =
+            (my_page_is_pending[std::size_t(addr) / mcal_eep_page_size].exchange(true, std::memory_order_acq_rel) == false);
+
+          if(page_is_newly_pending)
+          {
+            static_cast<void>(my_pending_count.fetch_add(1U, std::memory_order_relaxed));
+          }
+        }
+
+        if(page_is_newly_pending)
+        {
+          my_condition.notify_all();
+        }
+      }
+    }
+
+    std::uint8_t read(const mcal::eep::address_type addr) const
+    {
+      return ((addr < mcal::eep::address_type(mcal_eep_size)) ? my_image[std::size_t(addr)].load(std::memory_order_relaxed)
+                                                              : UINT8_C(0xFF));
+    }
+
+    bool is_busy() const
+    {
+      return (my_pending_count.load(std::memory_order_acquire) != 0U);
+    }
+
+    void flush()
+    {
+      std::unique_lock<std::mutex> lock(my_mutex);
+
+      my_condition.wait(lock, [this]() -> bool { return (is_busy() == false); });
+    }
+
+    std::uint32_t get_page_wear_count(const mcal::eep::address_type page_index) const
+    {
+      return ((page_index < mcal::eep::address_type(mcal_eep_page_count)) ? my_wear_count[std::size_t(page_index)].load(std::memory_order_relaxed)
+                                                                          : 0U);
+    }
+
+  private:
+    mcal_eep_file                                               my_file;
+    std::array<std::atomic<std::uint8_t>,  mcal_eep_size>       my_image;
+    std::array<std::atomic<bool>,          mcal_eep_page_count> my_page_is_pending;
+    std::array<std::atomic<std::uint32_t>, mcal_eep_page_count> my_wear_count;
+    std::atomic<std::uint32_t>                                  my_pending_count;
+    std::atomic<bool>                                           my_exit_request;
+    std::mutex                                                  my_mutex;
+    std::condition_variable                                     my_condition;
+    std::thread                                                 my_thread;
+
+    static constexpr std::size_t wear_count_offset(const std::size_t page_index)
+    {
+      return mcal_eep_size + (page_index * sizeof(std::uint32_t));
+    }
+
+    void program_page(const std::size_t page_index, const bool exit_is_requested)
+    {
+      if(exit_is_requested == false)
+      {
+        std::this_thread::sleep_for(std::chrono::microseconds(MCAL_EEP_PAGE_WRITE_TIME));
+      }
+
+      if(my_file.is_open())
+      {
+        std::uint8_t* page = my_file.memory() + (page_index * mcal_eep_page_size);
+
+        for(std::size_t index = 0U; index < mcal_eep_page_size; ++index)
+        {
+          page[index] = my_image[(page_index * mcal_eep_page_size) + index].load(std::memory_order_relaxed);
+        }
+      }
+
+      const std::uint32_t wear_count = my_wear_count[page_index].fetch_add(1U, std::memory_order_relaxed) + 1U;
+
+      if(my_file.is_open())
+      {
+        std::memcpy(my_file.memory() + wear_count_offset(page_index), &wear_count, sizeof(std::uint32_t));
+
+        my_file.sync_page(page_index);
+      }
+    }
+
+    static void thread_function(mcal_eep_device* device)
+    {
+      for(;;)
+      {
+        {
+          std::unique_lock<std::mutex> lock(device->my_mutex);
+
+          device->my_condition.wait(lock,
+                                    [device]() -> bool
+                                    {
+                                      return (   device->is_busy()
+                                              || device->my_exit_request.load(std::memory_order_relaxed));
+                                    });
+        }
+
+        const bool exit_is_requested = device->my_exit_request.load(std::memory_order_relaxed);
+
+        for(std::size_t page_index = 0U; page_index < mcal_eep_page_count; ++page_index)
+        {
+          // A page that is written again while it is programmed
+          // becomes pending again, and it is programmed once more.
+          if(device->my_page_is_pending[page_index].exchange(false, std::memory_order_acq_rel))
+          {
+            device->program_page(page_index, exit_is_requested);
+
+            std::uint32_t pending_count;
+
+            {
+              const std::lock_guard<std::mutex> lock(device->my_mutex);
+
+              pending_count = device->my_pending_count.fetch_sub(1U, std::memory_order_release) - 1U;
+            }
+
+            // Release the waits of flush when the last page is programmed.
+            if(pending_count == 0U)
+            {
+              device->my_condition.notify_all();
+            }
+          }
+        }
+
+        if(exit_is_requested && (device->is_busy() == false))
+        {
+          break;
+        }
+      }
+    }
+  };
+
+  mcal_eep_device& mcal_eep_the_device()
+  {
+    static mcal_eep_device the_device;
+
+    return the_device;
+  }
+}
+
+void mcal::eep::init(const config_type*)
+{
+  // Open the file of the host EEPROM.
+  static_cast<void>(mcal_eep_the_device());
+}
 
 void mcal::eep::write(const address_type addr, const std::uint8_t data)
 {
-  static_cast<void>(addr);
-  static_cast<void>(data);
+  mcal_eep_the_device().write(addr, data);
 }
 
 std::uint8_t mcal::eep::read(const address_type addr)
 {
-  static_cast<void>(addr);
+  return mcal_eep_the_device().read(addr);
+}
+
+bool mcal::eep::is_busy()
+{
+  return mcal_eep_the_device().is_busy();
+}
 
-  return std::uint8_t(0U);
+void mcal::eep::flush()
+{
+  mcal_eep_the_device().flush();
+}
+
+std::uint32_t mcal::eep::get_page_wear_count(const address_type page_index)
+{
+  return mcal_eep_the_device().get_page_wear_count(page_index);
 }
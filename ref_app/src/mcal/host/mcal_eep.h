@@ -1,8 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2018 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
 #ifndef MCAL_EEP_2018_12_15_H_
   #define MCAL_EEP_2018_12_15_H_
 
   #include <cstdint>
 
+  // A write to the host EEPROM goes to a RAM image of the memory
+  // and marks its page as pending. A background thread programs
+  // the pending pages, each with the page write time. Several writes
+  // to a page before it is programmed are batched into one program
+  // cycle of the page, which counts as one wear.
+
+  // The persistence of the host EEPROM is opt-in. With it, the memory
+  // followed by one 32-bit wear counter per page is kept in a file
+  // (MCAL_EEP_FILE_NAME, memory-mapped on POSIX hosts), into which
+  // the pages are programmed. Without it, the memory is erased and
+  // the wear is counted from zero in each run, and no file is used.
+  #if !defined(MCAL_EEP_PERSISTENT)
+  #define MCAL_EEP_PERSISTENT 0
+  //#define MCAL_EEP_PERSISTENT 1
+  #endif
+
+  // The file of the host EEPROM (with the persistence).
+  #if !defined(MCAL_EEP_FILE_NAME)
+  #define MCAL_EEP_FILE_NAME "ref_app_eep.bin"
+  #endif
+
+  // The size of the host EEPROM (in bytes).
+  #if !defined(MCAL_EEP_SIZE)
+  #define MCAL_EEP_SIZE 4096U
+  #endif
+
+  // The page size of the host EEPROM (in bytes).
+  #if !defined(MCAL_EEP_PAGE_SIZE)
+  #define MCAL_EEP_PAGE_SIZE 64U
+  #endif
+
+  // The time to program one page (in microseconds).
+  #if !defined(MCAL_EEP_PAGE_WRITE_TIME)
+  #define MCAL_EEP_PAGE_WRITE_TIME 5000U
+  #endif
+
   namespace mcal
   {
     namespace eep
@@ -10,10 +53,20 @@
       using config_type  = void;
       using address_type = std::uint64_t;
 
-      inline void init(const config_type*) { }
+      void init(const config_type*);
 
       void         write(const address_type addr, const std::uint8_t data);
       std::uint8_t read (const address_type addr);
+
+      // The host EEPROM is busy while pages are pending.
+      bool is_busy();
+
+      // Wait until all the pending pages are programmed.
+      void flush();
+
+      // The number of program cycles of a page (over all runs
+      // with the persistence, otherwise in this run).
+      std::uint32_t get_page_wear_count(const address_type page_index);
     }
   }
 
@@ -1,50 +1,66 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2019.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
 
 #include <mcal_gpt.h>
 
+#if (MCAL_GPT_VIRTUAL_TIME == 1)
+
 namespace
 {
-  using mcal_gpt_time_point_type =
-    std::chrono::high_resolution_clock::time_point;
-
-  static const mcal_gpt_time_point_type& mcal_gpt_time_point_init()
-  {
-    static const mcal_gpt_time_point_type init =
-      std::chrono::high_resolution_clock::now();
+  std::atomic<mcal::gpt::value_type> mcal_gpt_virtual_time;
+}
 
-    return init;
-  }
+mcal::gpt::value_type mcal::gpt::secure::get_time_elapsed()
+{
+  // Each read of the virtual system tick costs one step of time.
+  return mcal_gpt_virtual_time.fetch_add(value_type(MCAL_GPT_VIRTUAL_TIME_STEP));
+}
 
-  std::uint_fast16_t mcal_gpt_sleep_prescaler;
+void mcal::gpt::secure::advance_virtual_time(const value_type microseconds)
+{
+  static_cast<void>(mcal_gpt_virtual_time.fetch_add(microseconds));
 }
 
+#elif defined(__unix__) || defined(__APPLE__)
+
 mcal::gpt::value_type mcal::gpt::secure::get_time_elapsed()
 {
-  ++mcal_gpt_sleep_prescaler;
-
-  if((mcal_gpt_sleep_prescaler % UINT16_C(8192)) == 0U)
-  {
-    // Sleep in order to reduce the load on a PC target.
-    std::this_thread::sleep_for(std::chrono::milliseconds(3U));
-  }
-  else
-  {
-    std::this_thread::yield();
-  }
+  // Read the monotonic clock, which is served by the vDSO
+  // (without a system call) on Linux, and return the system tick
+  // with a resolution of 1us. The tick starts at an arbitrary point.
+  // The host does not yield or sleep here. Instead, the idle task
+  // waits for the next task deadline (see mcal::cpu::wait_for_wakeup).
+  timespec ts;
+
+  static_cast<void>(::clock_gettime(CLOCK_MONOTONIC, &ts));
+
+  return static_cast<mcal::gpt::value_type>(  (static_cast<mcal::gpt::value_type>(ts.tv_sec) * UINT32_C(1000000))
+                                            + (static_cast<mcal::gpt::value_type>(ts.tv_nsec) / UINT32_C(1000)));
+}
 
+#else
+
+mcal::gpt::value_type mcal::gpt::secure::get_time_elapsed()
+{
+  // Read the monotonic steady clock and return the system tick
+  // with a resolution of 1us. The tick starts at an arbitrary point.
   const std::chrono::microseconds duration_in_microseconds =
     std::chrono::duration_cast<std::chrono::microseconds>
-      (std::chrono::high_resolution_clock::now() - mcal_gpt_time_point_init());
+      (std::chrono::steady_clock::now().time_since_epoch());
 
-  // Return the system tick with a resolution of 1us.
   return static_cast<mcal::gpt::value_type>(duration_in_microseconds.count());
 }
+
+#endif
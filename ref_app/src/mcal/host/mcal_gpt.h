@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2018.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -13,6 +13,22 @@
 
   #include <util/utility/util_noexcept.h>
 
+  // Select the virtual time (1) or the wall-clock time (0) of the host.
+  // In the virtual time, the system tick advances by a small step on
+  // each read of the tick (so that blocking delays terminate), and it
+  // jumps directly to the next task deadline when the idle task waits.
+  // Simulations of hours of system time then run in seconds and are
+  // reproducible from run to run. The virtual time requires one of the
+  // single-threaded schedulers.
+  #if !defined(MCAL_GPT_VIRTUAL_TIME)
+  #define MCAL_GPT_VIRTUAL_TIME   0
+  //#define MCAL_GPT_VIRTUAL_TIME   1
+  #endif
+
+  #if !defined(MCAL_GPT_VIRTUAL_TIME_STEP)
+  #define MCAL_GPT_VIRTUAL_TIME_STEP   1U
+  #endif
+
   // Forward declaration of the util::timer template class.
   namespace util
   {
@@ -20,6 +36,9 @@
     class timer;
   }
 
+  // Forward declaration of the idle wait, which advances the virtual time.
+  namespace mcal { namespace cpu { void wait_for_wakeup(const std::uint32_t wait_microseconds); } }
+
   namespace mcal
   {
     namespace gpt
@@ -33,6 +52,12 @@
       {
         static value_type get_time_elapsed();
 
+        #if (MCAL_GPT_VIRTUAL_TIME == 1)
+        static void advance_virtual_time(const value_type microseconds);
+
+        friend void ::mcal::cpu::wait_for_wakeup(const std::uint32_t);
+        #endif
+
         friend std::chrono::high_resolution_clock::time_point std::chrono::high_resolution_clock::now() UTIL_NOEXCEPT;
 
         template<typename unsigned_tick_type>
@@ -5,9 +5,332 @@
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <mcal_gpt.h>
 #include <mcal_irq.h>
 
+#if (MCAL_IRQ_EMULATION == 1)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+  typedef std::chrono::steady_clock mcal_irq_clock_type;
+
+  struct mcal_irq_isr_entry
+  {
+    mcal::irq::isr_type              isr;
+    mcal_irq_clock_type::duration    period;
+    mcal_irq_clock_type::time_point  due_time;
+    std::uint64_t                    latency_sum;
+    mcal::irq::isr_statistics_type   statistics;
+  };
+
+  // The global interrupt lock and the interrupt enable state
+  // of the calling thread (which acts like the state of a core).
+  // An interrupt that is due is pending until the interrupt thread
+  // has taken the lock. A task does not take the lock while an
+  // interrupt is pending, so that (like on a microcontroller)
+  // the pending interrupt runs as soon as the interrupts are enabled.
+  // While the interrupt thread runs an interrupt service routine,
+  // enable_all and disable_all leave the lock alone, so that (like
+  // on a microcontroller) no task runs before the routine returns.
+  // The lock is a mutex (rather than a spinlock), so that the
+  // interrupt thread with its real-time priority blocks (and does
+  // not starve the task that holds the lock) on a single core.
+  std::mutex                   mcal_irq_lock;
+  std::atomic<bool>            mcal_irq_is_pending;
+  thread_local bool            mcal_irq_is_disabled;
+  thread_local bool            mcal_irq_is_in_isr;
+  std::atomic<std::uint32_t>   mcal_irq_lock_contention_count;
+
+  // The registered interrupt service routines, of which the first
+  // mcal_irq_isr_count are published to the interrupt thread.
+  // The registration is serialized by the mutex, and it notifies
+  // the interrupt thread, which waits on the condition variable
+  // for its next due time.
+  std::array<mcal_irq_isr_entry, MCAL_IRQ_ISR_COUNT> mcal_irq_isr_entries;
+  std::atomic<std::size_t>                           mcal_irq_isr_count;
+  std::mutex                                         mcal_irq_register_mutex;
+
+  // The condition variable is never destroyed, since the (detached)
+  // interrupt thread still waits on it when the program exits.
+  std::condition_variable& mcal_irq_register_condition()
+  {
+    static std::condition_variable* const the_condition = new std::condition_variable();
+
+    return *the_condition;
+  }
+
+  #if (MCAL_GPT_VIRTUAL_TIME == 0)
+  void mcal_irq_thread_function()
+  {
+    #if defined(__linux__)
+    // Raise the priority of the interrupt thread if permitted.
+    sched_param parameter { };
+
+    parameter.sched_priority = sched_get_priority_max(SCHED_FIFO);
+
+    static_cast<void>(pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameter));
+    #endif
+
+    for(;;)
+    {
+      const std::size_t isr_count = mcal_irq_isr_count.load(std::memory_order_acquire);
+
+      // Find the next interrupt that is due.
+      std::size_t next_index = 0U;
+
+      for(std::size_t index = 1U; index < isr_count; ++index)
+      {
+        if(mcal_irq_isr_entries[index].due_time < mcal_irq_isr_entries[next_index].due_time)
+        {
+          next_index = index;
+        }
+      }
+
+      mcal_irq_isr_entry& the_entry = mcal_irq_isr_entries[next_index];
+
+      // Wait for the due time. A newly registered interrupt ends
+      // the wait, and the next interrupt is found once more.
+      {
+        std::unique_lock<std::mutex> lock(mcal_irq_register_mutex);
+
+        const bool isr_is_registered =
+          mcal_irq_register_condition().wait_until(lock,
+                                                   the_entry.due_time,
+                                                   [isr_count]() -> bool
+                                                   {
+                                                     return (mcal_irq_isr_count.load(std::memory_order_relaxed) != isr_count);
+                                                   });
+
+        if(isr_is_registered)
+        {
+          continue;
+        }
+      }
+
+      // Take the interrupt lock. While it is held, the interrupts
+      // are masked, and the interrupt remains pending.
+      mcal_irq_is_pending.store(true, std::memory_order_seq_cst);
+
+      const bool interrupt_is_masked = (mcal_irq_lock.try_lock() == false);
+
+      if(interrupt_is_masked)
+      {
+        mcal_irq_lock.lock();
+      }
+
+      mcal_irq_is_pending.store(false, std::memory_order_relaxed);
+
+      mcal_irq_is_disabled = true;
+
+      // The statistics are only updated while the lock is held,
+      // since get_isr_statistics reads them under the lock.
+      if(interrupt_is_masked)
+      {
+        ++the_entry.statistics.masked_count;
+      }
+
+      const std::uint64_t latency =
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(mcal_irq_clock_type::now() - the_entry.due_time).count());
+
+      mcal::irq::isr_statistics_type& statistics = the_entry.statistics;
+
+      statistics.latency_min = ((latency < statistics.latency_min) ? latency : statistics.latency_min);
+      statistics.latency_max = ((latency > statistics.latency_max) ? latency : statistics.latency_max);
+
+      the_entry.latency_sum += latency;
+
+      ++statistics.call_count;
+
+      mcal_irq_is_in_isr = true;
+
+      the_entry.isr();
+
+      mcal_irq_is_in_isr = false;
+
+      // The lock is released when the interrupt service routine
+      // returns, even if it has enabled the interrupts.
+      mcal_irq_is_disabled = false;
+
+      mcal_irq_lock.unlock();
+
+      // The next due time follows the period. An interrupt that
+      // is missed by more than one period is not repeated.
+      the_entry.due_time += the_entry.period;
+
+      const mcal_irq_clock_type::time_point now = mcal_irq_clock_type::now();
+
+      if(the_entry.due_time + the_entry.period < now)
+      {
+        the_entry.due_time = now;
+      }
+    }
+  }
+  #endif
+}
+
 void mcal::irq::init(const config_type*)
 {
   mcal::irq::enable_all();
 }
+
+void mcal::irq::enable_all()
+{
+  if(mcal_irq_is_disabled && (mcal_irq_is_in_isr == false))
+  {
+    mcal_irq_is_disabled = false;
+
+    mcal_irq_lock.unlock();
+  }
+}
+
+void mcal::irq::disable_all()
+{
+  if((mcal_irq_is_disabled == false) && (mcal_irq_is_in_isr == false))
+  {
+    if(mcal_irq_is_pending.load(std::memory_order_seq_cst) || (mcal_irq_lock.try_lock() == false))
+    {
+      static_cast<void>(mcal_irq_lock_contention_count.fetch_add(1U, std::memory_order_relaxed));
+
+      // Let a pending interrupt run first.
+      for(;;)
+      {
+        while(mcal_irq_is_pending.load(std::memory_order_seq_cst))
+        {
+          std::this_thread::yield();
+        }
+
+        mcal_irq_lock.lock();
+
+        if(mcal_irq_is_pending.load(std::memory_order_seq_cst) == false)
+        {
+          break;
+        }
+
+        mcal_irq_lock.unlock();
+      }
+    }
+
+    mcal_irq_is_disabled = true;
+  }
+}
+
+bool mcal::irq::register_isr(const isr_type isr,
+                             const std::uint32_t period_microseconds,
+                             std::size_t& isr_index)
+{
+  #if (MCAL_GPT_VIRTUAL_TIME == 1)
+
+  // The real-time interrupt thread would break the reproducibility.
+  static_cast<void>(isr);
+  static_cast<void>(period_microseconds);
+  static_cast<void>(isr_index);
+
+  return false;
+
+  #else
+
+  if((isr == nullptr) || (period_microseconds == 0U))
+  {
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(mcal_irq_register_mutex);
+
+  const std::size_t isr_count = mcal_irq_isr_count.load(std::memory_order_relaxed);
+
+  const bool register_is_ok = (isr_count < std::size_t(MCAL_IRQ_ISR_COUNT));
+
+  if(register_is_ok)
+  {
+    // The interrupt service routines are only registered (and never
+    // unregistered), so an entry is filled before it is published.
+    // Since the interrupt thread only reads the entries that were
+    // published before it began its current wait, the entry being
+    // filled here is not in use.
+    mcal_irq_isr_entry& the_entry = mcal_irq_isr_entries[isr_count];
+
+    the_entry.isr         = isr;
+    the_entry.period      = std::chrono::microseconds(period_microseconds);
+    the_entry.due_time    = mcal_irq_clock_type::now() + the_entry.period;
+    the_entry.latency_sum = 0U;
+    the_entry.statistics  = { 0U, 0U, (std::numeric_limits<std::uint64_t>::max)(), 0U, 0U };
+
+    isr_index = isr_count;
+
+    mcal_irq_isr_count.store(isr_count + 1U, std::memory_order_release);
+  }
+
+  lock.unlock();
+
+  if(register_is_ok)
+  {
+    // Start the interrupt thread with the first interrupt,
+    // or else let it find its next interrupt once more.
+    if(isr_count == 0U)
+    {
+      std::thread(mcal_irq_thread_function).detach();
+    }
+    else
+    {
+      mcal_irq_register_condition().notify_one();
+    }
+  }
+
+  return register_is_ok;
+
+  #endif
+}
+
+void mcal::irq::get_isr_statistics(const std::size_t isr_index, isr_statistics_type& statistics)
+{
+  // The statistics are read while interrupts are masked,
+  // so that they are not updated during the copy.
+  mcal::irq::disable_all();
+
+  if(isr_index < mcal_irq_isr_count.load(std::memory_order_acquire))
+  {
+    const mcal_irq_isr_entry& the_entry = mcal_irq_isr_entries[isr_index];
+
+    statistics = the_entry.statistics;
+
+    statistics.latency_mean = ((statistics.call_count != 0U) ? (the_entry.latency_sum / statistics.call_count) : 0U);
+
+    if(statistics.call_count == 0U)
+    {
+      statistics.latency_min = 0U;
+    }
+  }
+  else
+  {
+    statistics = { 0U, 0U, 0U, 0U, 0U };
+  }
+
+  mcal::irq::enable_all();
+}
+
+std::uint32_t mcal::irq::get_lock_contention_count()
+{
+  return mcal_irq_lock_contention_count.load(std::memory_order_relaxed);
+}
+
+#else
+
+void mcal::irq::init(const config_type*)
+{
+  mcal::irq::enable_all();
+}
+
+#endif // MCAL_IRQ_EMULATION
@@ -8,6 +8,30 @@
 #ifndef MCAL_IRQ_2010_04_10_H_
   #define MCAL_IRQ_2010_04_10_H_
 
+  #include <cstddef>
+  #include <cstdint>
+
+  // The emulation of interrupts on the host. An interrupt thread
+  // calls the registered interrupt service routines at their rates.
+  // The interrupts are masked by a global interrupt lock: disable_all
+  // takes the lock and enable_all releases it (without nesting, like
+  // the interrupt enable flag of a microcontroller), and the interrupt
+  // thread holds it while it calls an interrupt service routine
+  // (in which enable_all and disable_all have no effect).
+  // So an interrupt service routine never runs inside a critical
+  // section of a task, and a critical section of a task never begins
+  // while an interrupt service routine runs. With several scheduler
+  // threads, the lock also acts like a multicore interrupt lock.
+  // The interrupt emulation is not available in the virtual time.
+  #if !defined(MCAL_IRQ_EMULATION)
+  #define MCAL_IRQ_EMULATION 1
+  #endif
+
+  // The maximum number of the interrupt service routines.
+  #if !defined(MCAL_IRQ_ISR_COUNT)
+  #define MCAL_IRQ_ISR_COUNT 4U
+  #endif
+
   namespace mcal
   {
     namespace irq
@@ -16,8 +40,44 @@
 
       void init(const config_type*);
 
+      #if (MCAL_IRQ_EMULATION == 1)
+
+      typedef void(*isr_type)();
+
+      // The latency of an interrupt is the time from its due time
+      // to the call of its interrupt service routine (in nanoseconds).
+      // A masked interrupt is due while the interrupts are disabled.
+      struct isr_statistics_type
+      {
+        std::uint32_t call_count;
+        std::uint32_t masked_count;
+        std::uint64_t latency_min;
+        std::uint64_t latency_max;
+        std::uint64_t latency_mean;
+      };
+
+      void enable_all ();
+      void disable_all();
+
+      // Register an interrupt service routine, which is called
+      // every period_microseconds. The index identifies its statistics.
+      bool register_isr(const isr_type isr,
+                        const std::uint32_t period_microseconds,
+                        std::size_t& isr_index);
+
+      void get_isr_statistics(const std::size_t isr_index, isr_statistics_type& statistics);
+
+      // The number of times that disable_all had to wait for the
+      // interrupt lock (held by an interrupt service routine or,
+      // with several scheduler threads, by another critical section).
+      std::uint32_t get_lock_contention_count();
+
+      #else
+
       inline void enable_all () { }
       inline void disable_all() { }
+
+      #endif
     }
   }
 
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2018.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -7,6 +7,338 @@
 
 #include <mcal_port.h>
 
+#if (MCAL_PORT_SIMULATION == 1)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <mcal_cpu.h>
+#include <mcal_gpt.h>
+#include <util/utility/util_time.h>
+
+namespace
+{
+  static_assert((MCAL_PORT_RECORD_COUNT & (MCAL_PORT_RECORD_COUNT - 1U)) == 0U,
+                "the number of port records must be a power of two");
+
+  typedef mcal::port::simulation::record_type record_type;
+
+  typedef util::timer<mcal::gpt::value_type> mcal_port_timer_type;
+
+  constexpr std::uint32_t mcal_port_record_mask = std::uint32_t(MCAL_PORT_RECORD_COUNT - 1U);
+
+  // A slot of the ring buffer. Its fields are atomic, since a slot
+  // can be read while it is overwritten. The sequence number is
+  // cleared before the other fields are written and it is set after
+  // them, so that the reader can detect and skip such a slot.
+  struct mcal_port_slot_type
+  {
+    std::atomic<std::uint64_t> time_ns;
+    std::atomic<std::uint32_t> sequence;
+    std::atomic<std::uint8_t>  pin;
+    std::atomic<std::uint8_t>  level;
+  };
+
+  // The ring buffer of the transitions and the (free-running)
+  // sequence number of the next transition, like in os::trace.
+  // A transition overwrites the oldest one.
+  std::array<mcal_port_slot_type, MCAL_PORT_RECORD_COUNT> mcal_port_slots;
+  std::atomic<std::uint32_t>                              mcal_port_head;
+
+  // The levels of the pins (one bit per pin).
+  std::atomic<std::uint32_t> mcal_port_levels;
+
+  std::uint64_t mcal_port_get_time_ns()
+  {
+    #if (MCAL_GPT_VIRTUAL_TIME == 1)
+    // In the virtual time, the transitions are stamped
+    // with the system tick, which counts microseconds.
+    return std::uint64_t(mcal_port_timer_type::get_mark() / mcal_port_timer_type::microseconds(1U)) * UINT64_C(1000);
+    #else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    #endif
+  }
+
+  void mcal_port_record(const std::uint_fast8_t pin, const bool level_is_high)
+  {
+    const std::uint32_t sequence = mcal_port_head.fetch_add(1U, std::memory_order_relaxed);
+
+    mcal_port_slot_type& the_slot = mcal_port_slots[sequence & mcal_port_record_mask];
+
+    // Invalidate the slot (the sequence number zero is never
+    // accepted by the reader) before its fields are written.
+    the_slot.sequence.store(0U, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    the_slot.time_ns.store(mcal_port_get_time_ns(),                             std::memory_order_relaxed);
+    the_slot.pin    .store(static_cast<std::uint8_t>(pin),                      std::memory_order_relaxed);
+    the_slot.level  .store(static_cast<std::uint8_t>(level_is_high ? 1U : 0U), std::memory_order_relaxed);
+
+    // Publish the transition by writing its sequence number last.
+    the_slot.sequence.store(std::uint32_t(sequence + 1U), std::memory_order_release);
+  }
+
+  // Write the VCD file and print the pulse statistics at exit.
+  std::atomic<bool> mcal_port_is_written_at_exit;
+
+  void mcal_port_write_at_exit()
+  {
+    // Write once, at the normal exit or at the quick exit
+    // that the host performs upon SIGINT or SIGTERM.
+    if(   (mcal_port_is_written_at_exit.exchange(true) == false)
+       && (mcal_port_head.load(std::memory_order_acquire) != 0U))
+    {
+      static_cast<void>(mcal::port::simulation::write_vcd(MCAL_PORT_VCD_FILE_NAME));
+
+      for(std::uint_fast8_t pin = 0U; pin < mcal::port::pin_count; ++pin)
+      {
+        mcal::port::simulation::pulse_statistics_type statistics;
+
+        mcal::port::simulation::get_pulse_statistics(pin, statistics);
+
+        if(statistics.pulse_count != 0U)
+        {
+          std::printf("port pin %u: %lu high pulses, width min/mean/max: %llu/%llu/%llu ns\n",
+                      unsigned(pin),
+                      static_cast<unsigned long>(statistics.pulse_count),
+                      static_cast<unsigned long long>(statistics.width_min),
+                      static_cast<unsigned long long>(statistics.width_mean),
+                      static_cast<unsigned long long>(statistics.width_max));
+        }
+      }
+
+      static_cast<void>(std::fflush(stdout));
+    }
+  }
+
+  // The dump is not written in a signal handler. Instead, the host
+  // exits with std::quick_exit upon SIGINT or SIGTERM (see mcal_cpu).
+  struct mcal_port_exit_registration
+  {
+    mcal_port_exit_registration()
+    {
+      static_cast<void>(std::atexit       (mcal_port_write_at_exit));
+      static_cast<void>(std::at_quick_exit(mcal_port_write_at_exit));
+
+      mcal::cpu::exit_on_signal();
+    }
+  };
+
+  const mcal_port_exit_registration mcal_port_the_exit_registration;
+}
+
+void mcal::port::simulation::set_pin_level(const std::uint_fast8_t pin, const bool level_is_high)
+{
+  const std::uint32_t pin_mask = std::uint32_t(UINT32_C(1) << pin);
+
+  const std::uint32_t levels =
+    (level_is_high ? mcal_port_levels.fetch_or (pin_mask,                   std::memory_order_relaxed)
+                   : mcal_port_levels.fetch_and(std::uint32_t(~pin_mask), std::memory_order_relaxed));
+
+  // Record the transition only if the level changes.
+  if(((levels & pin_mask) != 0U) != level_is_high)
+  {
+    mcal_port_record(pin, level_is_high);
+  }
+}
+
+bool mcal::port::simulation::get_pin_level(const std::uint_fast8_t pin)
+{
+  return ((mcal_port_levels.load(std::memory_order_relaxed) & std::uint32_t(UINT32_C(1) << pin)) != 0U);
+}
+
+void mcal::port::simulation::toggle_pin(const std::uint_fast8_t pin)
+{
+  const std::uint32_t pin_mask = std::uint32_t(UINT32_C(1) << pin);
+
+  const std::uint32_t levels = mcal_port_levels.fetch_xor(pin_mask, std::memory_order_relaxed);
+
+  mcal_port_record(pin, ((levels & pin_mask) == 0U));
+}
+
+std::size_t mcal::port::simulation::get_records(record_type* records, const std::size_t record_count)
+{
+  const std::uint32_t head = mcal_port_head.load(std::memory_order_acquire);
+
+  std::uint32_t available = ((head < std::uint32_t(MCAL_PORT_RECORD_COUNT)) ? head : std::uint32_t(MCAL_PORT_RECORD_COUNT));
+
+  if(std::size_t(available) > record_count)
+  {
+    available = static_cast<std::uint32_t>(record_count);
+  }
+
+  std::size_t count = 0U;
+
+  for(std::uint32_t sequence = head - available; sequence != head; ++sequence)
+  {
+    const mcal_port_slot_type& the_slot = mcal_port_slots[sequence & mcal_port_record_mask];
+
+    const std::uint32_t expected_sequence = static_cast<std::uint32_t>(sequence + 1U);
+
+    // Skip transitions that are incomplete or that are overwritten
+    // during the copy. The sequence number is read before and
+    // after the fields, like in a sequence lock.
+    if(   (expected_sequence != 0U)
+       && (the_slot.sequence.load(std::memory_order_acquire) == expected_sequence))
+    {
+      record_type the_copy;
+
+      the_copy.time_ns = the_slot.time_ns.load(std::memory_order_relaxed);
+      the_copy.pin     = the_slot.pin    .load(std::memory_order_relaxed);
+      the_copy.level   = the_slot.level  .load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if(the_slot.sequence.load(std::memory_order_relaxed) == expected_sequence)
+      {
+        records[count] = the_copy;
+
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+void mcal::port::simulation::get_pulse_statistics(const std::uint_fast8_t pin, pulse_statistics_type& statistics)
+{
+  // A high pulse lasts from a rising transition of the pin
+  // to its next falling transition.
+  std::vector<record_type> records(MCAL_PORT_RECORD_COUNT);
+
+  records.resize(get_records(records.data(), records.size()));
+
+  statistics.pulse_count = 0U;
+  statistics.width_min   = (std::numeric_limits<std::uint64_t>::max)();
+  statistics.width_max   = 0U;
+  statistics.width_mean  = 0U;
+
+  std::uint64_t width_sum  = 0U;
+  std::uint64_t rise_time  = 0U;
+  bool          rise_is_set = false;
+
+  for(const record_type& the_record : records)
+  {
+    if(the_record.pin == pin)
+    {
+      if(the_record.level != 0U)
+      {
+        rise_time   = the_record.time_ns;
+        rise_is_set = true;
+      }
+      else if(rise_is_set)
+      {
+        const std::uint64_t width = the_record.time_ns - rise_time;
+
+        statistics.width_min = ((width < statistics.width_min) ? width : statistics.width_min);
+        statistics.width_max = ((width > statistics.width_max) ? width : statistics.width_max);
+
+        width_sum += width;
+
+        ++statistics.pulse_count;
+
+        rise_is_set = false;
+      }
+    }
+  }
+
+  if(statistics.pulse_count != 0U)
+  {
+    statistics.width_mean = width_sum / statistics.pulse_count;
+  }
+  else
+  {
+    statistics.width_min = 0U;
+  }
+}
+
+bool mcal::port::simulation::write_vcd(const char* file_name)
+{
+  std::vector<record_type> records(MCAL_PORT_RECORD_COUNT);
+
+  records.resize(get_records(records.data(), records.size()));
+
+  std::FILE* vcd_file = std::fopen(file_name, "w");
+
+  if(vcd_file == nullptr)
+  {
+    return false;
+  }
+
+  // Declare the pins that have transitions. The identifier
+  // of a pin is the printable character '!' plus the pin index.
+  std::uint32_t pins_used = 0U;
+
+  for(const record_type& the_record : records)
+  {
+    pins_used |= std::uint32_t(UINT32_C(1) << the_record.pin);
+  }
+
+  static_cast<void>(std::fputs("$timescale 1ns $end\n$scope module ref_app $end\n", vcd_file));
+
+  for(unsigned pin = 0U; pin < unsigned(mcal::port::pin_count); ++pin)
+  {
+    if((pins_used & std::uint32_t(UINT32_C(1) << pin)) != 0U)
+    {
+      static_cast<void>(std::fprintf(vcd_file, "$var wire 1 %c pin%u $end\n", char('!' + pin), pin));
+    }
+  }
+
+  static_cast<void>(std::fputs("$upscope $end\n$enddefinitions $end\n", vcd_file));
+
+  // The initial level of a pin is the opposite of its first transition.
+  static_cast<void>(std::fputs("#0\n$dumpvars\n", vcd_file));
+
+  std::uint32_t pins_initialized = 0U;
+
+  for(const record_type& the_record : records)
+  {
+    const std::uint32_t pin_mask = std::uint32_t(UINT32_C(1) << the_record.pin);
+
+    if((pins_initialized & pin_mask) == 0U)
+    {
+      static_cast<void>(std::fprintf(vcd_file, "%u%c\n", unsigned(the_record.level ^ 1U), char('!' + the_record.pin)));
+
+      pins_initialized |= pin_mask;
+    }
+  }
+
+  static_cast<void>(std::fputs("$end\n", vcd_file));
+
+  // Write the transitions with the time relative to the oldest one.
+  // Transitions of different threads can be slightly out of order,
+  // but the time of a VCD file must not decrease.
+  const std::uint64_t time_base = (records.empty() ? 0U : records.front().time_ns);
+
+  std::uint64_t time_previous = 0U;
+
+  for(const record_type& the_record : records)
+  {
+    const std::uint64_t time_vcd =
+      ((the_record.time_ns > time_base) ? (the_record.time_ns - time_base) : 0U);
+
+    if(time_vcd > time_previous)
+    {
+      static_cast<void>(std::fprintf(vcd_file, "#%llu\n", static_cast<unsigned long long>(time_vcd)));
+
+      time_previous = time_vcd;
+    }
+
+    static_cast<void>(std::fprintf(vcd_file, "%u%c\n", unsigned(the_record.level), char('!' + the_record.pin)));
+  }
+
+  return (std::fclose(vcd_file) == 0);
+}
+
+#endif // MCAL_PORT_SIMULATION
+
 void mcal::port::init(const config_type*)
 {
 }
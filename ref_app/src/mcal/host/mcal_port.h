@@ -8,6 +8,30 @@
 #ifndef MCAL_PORT_2012_06_27_H_
   #define MCAL_PORT_2012_06_27_H_
 
+  #include <cstddef>
+  #include <cstdint>
+
+  // The simulation of the host port pins (opt-in). Each transition
+  // of a pin is recorded with a nanosecond timestamp in a ring buffer
+  // (in the virtual time, with the system tick). At exit, including
+  // the exit of the host upon SIGINT or SIGTERM, the transitions are
+  // written as Value Change Dump (MCAL_PORT_VCD_FILE_NAME) and the
+  // pulse statistics of the pins are printed. Without the simulation,
+  // the port pins do nothing.
+  #if !defined(MCAL_PORT_SIMULATION)
+  #define MCAL_PORT_SIMULATION 0
+  //#define MCAL_PORT_SIMULATION 1
+  #endif
+
+  // The number of transitions in the ring buffer (a power of two).
+  #if !defined(MCAL_PORT_RECORD_COUNT)
+  #define MCAL_PORT_RECORD_COUNT 65536U
+  #endif
+
+  #if !defined(MCAL_PORT_VCD_FILE_NAME)
+  #define MCAL_PORT_VCD_FILE_NAME "ref_app_port.vcd"
+  #endif
+
   namespace mcal
   {
     namespace port
@@ -16,15 +40,63 @@
 
       void init(const config_type*);
 
+      constexpr std::uint_fast8_t pin_count = 32U;
+
+      #if (MCAL_PORT_SIMULATION == 1)
+      namespace simulation
+      {
+        // The transition of a pin.
+        struct record_type
+        {
+          std::uint64_t time_ns;
+          std::uint8_t  pin;
+          std::uint8_t  level;
+        };
+
+        // The statistics of the high pulses of a pin (in nanoseconds).
+        struct pulse_statistics_type
+        {
+          std::uint32_t pulse_count;
+          std::uint64_t width_min;
+          std::uint64_t width_max;
+          std::uint64_t width_mean;
+        };
+
+        void set_pin_level(const std::uint_fast8_t pin, const bool level_is_high);
+        bool get_pin_level(const std::uint_fast8_t pin);
+        void toggle_pin   (const std::uint_fast8_t pin);
+
+        // Copy the transitions of the ring buffer (oldest first).
+        std::size_t get_records(record_type* records, const std::size_t record_count);
+
+        void get_pulse_statistics(const std::uint_fast8_t pin, pulse_statistics_type& statistics);
+
+        bool write_vcd(const char* file_name);
+      }
+      #endif
+
+      // The port pin with the index pin_index (0...31).
+      template<const std::uint_fast8_t pin_index>
       class port_pin
       {
+      private:
+        static_assert(pin_index < pin_count, "the host port pin index is out of range");
+
       public:
         static void set_direction_output() noexcept { }
         static void set_direction_input () noexcept { }
+
+        #if (MCAL_PORT_SIMULATION == 1)
+        static void set_pin_high        () noexcept { simulation::set_pin_level(pin_index, true); }
+        static void set_pin_low         () noexcept { simulation::set_pin_level(pin_index, false); }
+        static bool read_input_value    () noexcept { return simulation::get_pin_level(pin_index); }
+        static void toggle_pin          () noexcept { simulation::toggle_pin(pin_index); }
+        #else
         static void set_pin_high        () noexcept { }
         static void set_pin_low         () noexcept { }
         static bool read_input_value    () noexcept { return false; }
         static void toggle_pin          () noexcept { }
+        #endif
       };
     }
   }
@@ -5,6 +5,7 @@
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <mcal_wdg_watchdog.h>
@@ -12,20 +13,58 @@
 const mcal::wdg::watchdog::timer_type::tick_type mcal::wdg::watchdog::my_period(timer_type::seconds(2U));
 mcal::wdg::watchdog mcal::wdg::watchdog::the_watchdog(watchdog::the_watchdog_thread_function);
 
-bool mcal::wdg::watchdog::get_watchdog_timeout()
+mcal::wdg::watchdog::timer_type::tick_type mcal::wdg::watchdog::get_max_usec_since_service()
 {
-  my_mutex.lock();
-  const bool timeout_result = my_timer.timeout();
-  my_mutex.unlock();
+  const timer_type::tick_type ticks_since_service =
+    the_watchdog.get_ticks_since_service(timer_type::get_mark());
 
-  return timeout_result;
+  const timer_type::tick_type max_since_service =
+    (std::max)(ticks_since_service, the_watchdog.my_max_since_service.load(std::memory_order_relaxed));
+
+  return max_since_service / timer_type::microseconds(1U);
+}
+
+mcal::wdg::watchdog::timer_type::tick_type mcal::wdg::watchdog::get_ticks_since_service(const timer_type::tick_type now) const
+{
+  return timer_type::tick_type(now - my_last_service.load(std::memory_order_acquire));
+}
+
+void mcal::wdg::watchdog::update_max_since_service(const timer_type::tick_type ticks_since_service)
+{
+  // The maximum is written by the trigger and by the supervisor,
+  // but it only changes when a new maximum is found.
+  timer_type::tick_type max_since_service = my_max_since_service.load(std::memory_order_relaxed);
+
+  while(   (ticks_since_service > max_since_service)
+        && (my_max_since_service.compare_exchange_weak(max_since_service,
+                                                       ticks_since_service,
+                                                       std::memory_order_relaxed) == false))
+  {
+    ;
+  }
 }
 
 void mcal::wdg::watchdog::reset_watchdog_timer()
 {
-  my_mutex.lock();
-  my_timer.start_relative(the_watchdog.my_period);
-  my_mutex.unlock();
+  // This is called from the idle task on each idle pass.
+  // It takes one read of the tick and one atomic store
+  // (plus an atomic load for the maximum time since service).
+  const timer_type::tick_type now = timer_type::get_mark();
+
+  const timer_type::tick_type ticks_since_service = get_ticks_since_service(now);
+
+  update_max_since_service(ticks_since_service);
+
+  #if (MCAL_GPT_VIRTUAL_TIME == 1)
+  if((my_timeout_has_occurred == false) && (ticks_since_service > my_period))
+  {
+    my_timeout_has_occurred = true;
+
+    std::cout << "error: at least one watchdog timeout has occurred" << std::endl;
+  }
+  #endif
+
+  my_last_service.store(now, std::memory_order_release);
 }
 
 void mcal::wdg::watchdog::the_watchdog_thread_function()
@@ -38,18 +77,33 @@ void mcal::wdg::watchdog::the_watchdog_thread_function()
   {
     if(timeout_has_occurred)
     {
-      std::cout << "error: at least one watchdog timeout has occurred" << std::endl;
+      std::cout << "error: at least one watchdog timeout has occurred, max time since service: "
+                << get_max_usec_since_service()
+                << "us"
+                << std::endl;
 
       std::this_thread::sleep_for(std::chrono::milliseconds(500U));
     }
     else
     {
-      if(watchdog::the_watchdog.get_watchdog_timeout())
+      const timer_type::tick_type ticks_since_service =
+        watchdog::the_watchdog.get_ticks_since_service(timer_type::get_mark());
+
+      if(ticks_since_service > my_period)
       {
+        watchdog::the_watchdog.update_max_since_service(ticks_since_service);
+
         timeout_has_occurred = true;
       }
+      else
+      {
+        // Sleep until the timeout can occur at the earliest.
+        // A service in the meantime only moves the timeout later.
+        const timer_type::tick_type ticks_until_timeout =
+          timer_type::tick_type(my_period - ticks_since_service);
 
-      std::this_thread::sleep_for(std::chrono::milliseconds(20U));
+        std::this_thread::sleep_for(std::chrono::microseconds((ticks_until_timeout / timer_type::microseconds(1U)) + 1U));
+      }
     }
   }
 }
@@ -8,7 +8,7 @@
 #ifndef MCAL_WDG_WATCHDOG_2013_12_11_H_
   #define MCAL_WDG_WATCHDOG_2013_12_11_H_
 
-  #include <mutex>
+  #include <atomic>
   #include <thread>
   #include <mcal_wdg.h>
   #include <util/utility/util_noncopyable.h>
@@ -20,6 +20,9 @@
     {
       class watchdog;
 
+      // The host watchdog. The trigger stores the time of the service
+      // in an atomic timestamp (without locking), and a supervisor
+      // thread checks the time since the last service.
       class watchdog : private util::noncopyable
       {
       public:
@@ -27,22 +30,40 @@
 
         ~watchdog() { }
 
+        // The maximum time (in microseconds) since the service,
+        // including the time since the last service.
+        static timer_type::tick_type get_max_usec_since_service();
+
       private:
         typedef void(*function_type)();
 
-        watchdog(function_type function) : my_timer (my_period),
-                                           my_mutex (),
-                                           my_thread(function) { }
+        #if (MCAL_GPT_VIRTUAL_TIME == 1)
+        // In the virtual time, the timeout is checked at each trigger,
+        // since a polling thread would read (and advance) the virtual
+        // tick at arbitrary points and break the reproducibility.
+        watchdog(function_type) : my_last_service        (timer_type::get_mark()),
+                                  my_max_since_service   (0U),
+                                  my_timeout_has_occurred(false) { }
+        #else
+        watchdog(function_type function) : my_last_service     (timer_type::get_mark()),
+                                           my_max_since_service(0U),
+                                           my_thread           (function) { }
+        #endif
 
         static const timer_type::tick_type my_period;
 
-        timer_type  my_timer;
-        std::mutex  my_mutex;
-        std::thread my_thread;
+        std::atomic<timer_type::tick_type> my_last_service;
+        std::atomic<timer_type::tick_type> my_max_since_service;
+        #if (MCAL_GPT_VIRTUAL_TIME == 1)
+        bool                               my_timeout_has_occurred;
+        #else
+        std::thread                        my_thread;
+        #endif
 
         static watchdog the_watchdog;
 
-        bool get_watchdog_timeout();
+        timer_type::tick_type get_ticks_since_service(const timer_type::tick_type now) const;
+        void update_max_since_service(const timer_type::tick_type ticks_since_service);
         void reset_watchdog_timer();
 
         static void the_watchdog_thread_function();
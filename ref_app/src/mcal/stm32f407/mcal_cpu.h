@@ -21,6 +21,14 @@
 
   inline void nop() { asm volatile("nop"); }
 
+  inline bool wait_for_wakeup_is_supported() { return false; }
+
+  inline void wait_for_wakeup(const std::uint32_t wait_microseconds) { static_cast<void>(wait_microseconds); }
+
+  inline void wakeup() { }
+
+  inline void exit_on_signal() { }
+
   } } // namespace mcal::cpu
 
 #endif // MCAL_CPU_2009_02_14_H_
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCAL_CONSOLE_2020_10_17_H_
+  #define MCAL_CONSOLE_2020_10_17_H_
+
+  #include <cstddef>
+  #include <cstdint>
+
+  // The number of lines in the ring buffer of the console output.
+  #if !defined(MCAL_CONSOLE_LINE_COUNT)
+  #define MCAL_CONSOLE_LINE_COUNT 256U
+  #endif
+
+  namespace mcal
+  {
+    namespace console
+    {
+      // The host console output of the LED, LCD and PWM drivers.
+      // A write copies the text and a timestamp into a lock-free
+      // ring buffer, and a background thread prints the lines
+      // in batches, so that the drivers never wait for the console.
+      // The text of a line is truncated to line_length characters.
+      // When the ring buffer is full, the line is dropped.
+      constexpr std::size_t line_length = 112U;
+
+      bool write(const char* pstr, const std::size_t length);
+
+      std::uint32_t get_dropped_count();
+    }
+  }
+
+#endif // MCAL_CONSOLE_2020_10_17_H_
@@ -8,6 +8,7 @@
 #ifndef MCAL_MEMORY_PROGMEM_2019_08_17_H_
   #define MCAL_MEMORY_PROGMEM_2019_08_17_H_
 
+  #include <stddef.h>
   #include <stdint.h>
 
   #define MY_PROGMEM
@@ -18,8 +19,7 @@
   #endif
 
   typedef uintptr_t mcal_progmem_uintptr_t;
-
-  #define MCAL_PROGMEM_ADDRESSOF(x) ((mcal_progmem_uintptr_t) (&(x)))
+  typedef ptrdiff_t mcal_progmem_ptrdiff_t;
 
   #define MCAL_PROGMEM_ADDRESSOF(x) ((mcal_progmem_uintptr_t) (&(x)))
 
@@ -1,9 +1,10 @@
 #ifndef MCAL_LCD_CONSOLE_2020_06_10_H_
   #define MCAL_LCD_CONSOLE_2020_06_10_H_
 
-  #include <iostream>
-  #include <string>
+  #include <algorithm>
+  #include <cstring>
 
+  #include <mcal_console.h>
   #include <mcal_lcd/mcal_lcd_base.h>
 
   namespace mcal { namespace lcd {
@@ -25,11 +26,17 @@
 
       if((pstr != nullptr) && (length > 0U))
       {
-        const std::string str(pstr, pstr + length);
+        // Print the line (via the buffered console).
+        char text[mcal::console::line_length];
 
-        std::cout << str << std::endl;
+        const std::size_t text_length =
+          (std::min)(std::size_t(length), std::size_t(mcal::console::line_length - 1U));
 
-        write_is_ok = true;
+        std::memcpy(text, pstr, text_length);
+
+        text[text_length] = '\n';
+
+        write_is_ok = mcal::console::write(text, text_length + 1U);
       }
       else
       {
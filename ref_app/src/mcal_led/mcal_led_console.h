@@ -2,8 +2,9 @@
   #define MCAL_LED_CONSOLE_2020_04_23_H_
 
   #include <cstdint>
-  #include <iostream>
+  #include <cstdio>
 
+  #include <mcal_console.h>
   #include <mcal_led/mcal_led_base.h>
 
   namespace mcal { namespace led {
@@ -22,12 +23,16 @@
       // Toggle the LED state.
       is_on = (!is_on);
 
-      // Print the LED state.
-      std::cout << "LED"
-                << unsigned(index)
-                << " is "
-                << (is_on ? "on" : "off")
-                << std::endl;
+      // Print the LED state (via the buffered console).
+      char text[16U];
+
+      const int length = std::snprintf(text,
+                                       sizeof(text),
+                                       "LED%u is %s\n",
+                                       unsigned(index),
+                                       (is_on ? "on" : "off"));
+
+      static_cast<void>(mcal::console::write(text, std::size_t(length)));
     }
 
   private:
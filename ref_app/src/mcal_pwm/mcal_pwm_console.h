@@ -8,10 +8,9 @@
 #ifndef MCAL_PWM_CONSOLE_2020_04_12_H_
   #define MCAL_PWM_CONSOLE_2020_04_12_H_
 
-  #include <iomanip>
-  #include <iostream>
-  #include <sstream>
+  #include <cstdio>
 
+  #include <mcal_console.h>
   #include <mcal_pwm/mcal_pwm_base.h>
 
   namespace mcal { namespace pwm {
@@ -30,17 +29,17 @@
     {
       base_class_type::my_duty_cycle = duty_cycle;
 
-      const float duty_cycle_as_percent = float(duty_cycle) / 10.0F;
+      // Print the duty cycle in percent (via the buffered console).
+      // The duty cycle is given in units of 0.1 percent.
+      char text[32U];
 
-      std::stringstream strm;
+      const int length = std::snprintf(text,
+                                       sizeof(text),
+                                       "duty cycle: %u.%u%%  \r",
+                                       unsigned(duty_cycle / 10U),
+                                       unsigned(duty_cycle % 10U));
 
-      strm << "duty cycle: "
-           << std::fixed
-           << std::setprecision(1)
-           << duty_cycle_as_percent
-           << "%";
-
-      std::cout << strm.str() + (std::string(2U, ' ') + "\r");
+      static_cast<void>(mcal::console::write(text, std::size_t(length)));
     }
 
     virtual ~pwm_console() = default;
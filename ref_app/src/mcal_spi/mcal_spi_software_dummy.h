@@ -33,6 +33,24 @@
       return true;
     }
 
+    virtual bool transceive(const std::uint8_t* p_send,
+                            std::uint8_t* p_recv,
+                            const std::size_t count)
+    {
+      // Transfer the block without a virtual call per byte.
+      // The dummy SPI receives zeros.
+      static_cast<void>(p_send);
+
+      if(p_recv != nullptr)
+      {
+        std::fill(p_recv, p_recv + count, UINT8_C(0));
+      }
+
+      base_class_type::recv_buffer = 0U;
+
+      return true;
+    }
+
     virtual void   select() { }
     virtual void deselect() { }
   };
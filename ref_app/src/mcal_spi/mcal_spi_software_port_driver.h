@@ -60,7 +60,36 @@
 
     virtual bool send(const std::uint8_t byte_to_send)
     {
-      base_class_type::recv_buffer = 0U;
+      base_class_type::recv_buffer = transfer_byte(byte_to_send);
+
+      return true;
+    }
+
+    virtual bool transceive(const std::uint8_t* p_send,
+                            std::uint8_t* p_recv,
+                            const std::size_t count)
+    {
+      // Transfer the block without a virtual call per byte.
+      for(std::size_t index = 0U; index < count; ++index)
+      {
+        base_class_type::recv_buffer = transfer_byte((p_send != nullptr) ? p_send[index] : UINT8_C(0xFF));
+
+        if(p_recv != nullptr)
+        {
+          p_recv[index] = base_class_type::recv_buffer;
+        }
+      }
+
+      return true;
+    }
+
+    virtual void   select() { port_pin_csn__type::set_pin_low(); }
+    virtual void deselect() { port_pin_csn__type::set_pin_high(); }
+
+  private:
+    static std::uint8_t transfer_byte(const std::uint8_t byte_to_send)
+    {
+      std::uint8_t byte_to_recv = 0U;
 
       for(std::uint_fast8_t bit_mask = UINT8_C(0x80); bit_mask != UINT8_C(0); bit_mask >>= 1U)
       {
@@ -77,17 +106,14 @@
 
         if(port_pin_miso_type::read_input_value())
         {
-          base_class_type::recv_buffer |= bit_mask;
+          byte_to_recv |= bit_mask;
         }
 
         mcal::helper::enable_all_interrupts<has_disable_enable_interrupts>();
       }
 
-      return true;
+      return byte_to_recv;
     }
-
-    virtual void   select() { port_pin_csn__type::set_pin_low(); }
-    virtual void deselect() { port_pin_csn__type::set_pin_high(); }
   };
 
   template<typename port_pin_sck__type,
@@ -115,6 +141,36 @@
     virtual ~spi_software_port_driver() = default;
 
     virtual bool send(const std::uint8_t byte_to_send)
+    {
+      transfer_byte(byte_to_send);
+
+      return true;
+    }
+
+    virtual bool transceive(const std::uint8_t* p_send,
+                            std::uint8_t* p_recv,
+                            const std::size_t count)
+    {
+      // Transfer the block without a virtual call per byte.
+      // Without MISO, the received bytes are zero.
+      for(std::size_t index = 0U; index < count; ++index)
+      {
+        transfer_byte((p_send != nullptr) ? p_send[index] : UINT8_C(0xFF));
+
+        if(p_recv != nullptr)
+        {
+          p_recv[index] = UINT8_C(0);
+        }
+      }
+
+      return true;
+    }
+
+    virtual void   select() { port_pin_csn__type::set_pin_low(); }
+    virtual void deselect() { port_pin_csn__type::set_pin_high(); }
+
+  private:
+    static void transfer_byte(const std::uint8_t byte_to_send)
     {
       for(std::uint_fast8_t bit_mask = UINT8_C(0x80); bit_mask != UINT8_C(0); bit_mask >>= 1U)
       {
@@ -128,12 +184,7 @@
 
         mcal::helper::enable_all_interrupts<true>();
       }
-
-      return true;
     }
-
-    virtual void   select() { port_pin_csn__type::set_pin_low(); }
-    virtual void deselect() { port_pin_csn__type::set_pin_high(); }
   };
 
   } } // namespace mcal::spi
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2018.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -8,23 +8,286 @@
 #include <algorithm>
 #include <array>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <mcal_cpu.h>
 #include <mcal_irq.h>
 #include <os/os.h>
 #include <os/os_task_control_block.h>
+#include <os/os_trace.h>
+
+#if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+#include <os/os_ready_queue.h>
+#elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD) && defined(MCAL_GPT_VIRTUAL_TIME) && (MCAL_GPT_VIRTUAL_TIME == 1)
+#error the multithreaded scheduler can not be used with the virtual time of the host
+#endif
 
 namespace
 {
   typedef std::array<os::task_control_block, OS_TASK_COUNT> task_list_type;
 
-  typedef std::uint_fast8_t task_index_type;
+  typedef std::conditional<((OS_TASK_COUNT + OS_TASK_POOL_SIZE) < std::size_t(UINT8_C(0xFF))),
+                           std::uint_fast8_t,
+                           std::uint_fast16_t>::type task_index_type;
 
   // The one (and only one) operating system task list.
   task_list_type os_task_list(OS_TASK_LIST);
 
+  // The pool of the control blocks of the tasks that are spawned and
+  // retired at runtime. The task index of a pool task is OS_TASK_COUNT
+  // plus its slot in the pool. The active list holds the slots of the
+  // spawned tasks in the order of their spawning, so that the retired
+  // tasks are not scanned at all.
+  struct task_pool_slot_type
+  {
+    alignas(os::task_control_block) std::uint8_t storage[sizeof(os::task_control_block)];
+  };
+
+  std::array<task_pool_slot_type, OS_TASK_POOL_SIZE> os_task_pool;
+  std::array<bool,                OS_TASK_POOL_SIZE> os_task_pool_slot_is_used;
+  std::array<bool,                OS_TASK_POOL_SIZE> os_task_pool_retire_is_pending;
+  std::array<task_index_type,     OS_TASK_POOL_SIZE> os_task_pool_active_list;
+  task_index_type                                    os_task_pool_active_count;
+
+  // The task index that denotes no task (for instance in the idle task).
+  constexpr task_index_type task_index_none = task_index_type(OS_TASK_COUNT + OS_TASK_POOL_SIZE);
+
+  os::task_control_block& get_task_pool_control_block(const std::size_t slot)
+  {
+    return *reinterpret_cast<os::task_control_block*>(os_task_pool[slot].storage);
+  }
+
+  os::task_control_block* get_task_control_block(const std::size_t index)
+  {
+    // Get the control block of a task of the task list or of the task pool.
+    if(index < OS_TASK_COUNT)
+    {
+      return &os_task_list[index];
+    }
+    else if((index < std::size_t(task_index_none)) && os_task_pool_slot_is_used[index - OS_TASK_COUNT])
+    {
+      return &get_task_pool_control_block(index - OS_TASK_COUNT);
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+
+  #if (OS_TASK_POOL_SIZE > 0U)
+  void task_pool_purge()
+  {
+    // Remove the retired tasks from the active list (keeping the order
+    // of the others) and free their slots.
+    task_index_type count = 0U;
+
+    for(task_index_type position = 0U; position < os_task_pool_active_count; ++position)
+    {
+      const task_index_type slot = os_task_pool_active_list[position];
+
+      if(os_task_pool_retire_is_pending[slot])
+      {
+        get_task_pool_control_block(slot).~task_control_block();
+
+        os_task_pool_retire_is_pending[slot] = false;
+        os_task_pool_slot_is_used     [slot] = false;
+      }
+      else
+      {
+        os_task_pool_active_list[count] = slot;
+
+        ++count;
+      }
+    }
+
+    os_task_pool_active_count = count;
+  }
+  #endif
+
+  // The queue of the work that is deferred by interrupt service routines.
+  os::deferred_queue<OS_DEFERRED_QUEUE_SIZE> os_deferred_queue;
+
   // The index of the running task.
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+  thread_local task_index_type os_task_index;
+  #else
   task_index_type os_task_index;
+  #endif
+
+  #if (   (OS_SCHEDULER_TYPE != OS_SCHEDULER_TYPE_MULTITHREAD)     \
+       && (OS_SCHEDULER_TYPE != OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE))
+
+  // The indices of the event-triggered tasks in the order of the task list.
+  std::array<task_index_type, OS_TASK_COUNT> os_event_task_list;
+
+  // The number of event-triggered tasks.
+  task_index_type os_event_task_count;
+
+  #endif
+
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+
+  typedef os::ready_queue<OS_TASK_COUNT> ready_queue_type;
+
+  // The ready queue holding the timer-ordered and the priority-ordered tasks.
+  ready_queue_type os_ready_queue(os_task_list.data());
+
+  // Indicate that an event has been set since the last scheduler pass.
+  volatile bool os_event_is_pending;
+
+  bool event_pending_flag_take()
+  {
+    // Take and clear the pending flag. The flag is cleared before
+    // the tasks are scanned for their events, so that an event
+    // being set during the scan is caught on the next pass.
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    return __atomic_exchange_n(&os_event_is_pending, false, __ATOMIC_SEQ_CST);
+    #else
+    const bool event_was_pending = os_event_is_pending;
+
+    os_event_is_pending = false;
+
+    return event_was_pending;
+    #endif
+  }
+
+  #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+
+  static_assert(OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC,
+                "the multithreaded scheduler requires the atomic event access");
+
+  // A task affinity group holds the indices of its tasks in the
+  // order of dispatch, with the event-triggered tasks ahead of
+  // the cyclic tasks, and the means for its worker thread to wait.
+  struct worker_group_type
+  {
+    std::array<task_index_type, OS_TASK_COUNT> task_list;
+    task_index_type                            task_count;
+    std::mutex                                 wakeup_mutex;
+    std::condition_variable                    wakeup_condition;
+    std::atomic<bool>                          wakeup_is_pending;
+    std::atomic<bool>                          is_waiting;
+  };
+
+  #if !defined(OS_TASK_AFFINITY_GROUP_LIST)
+  #error the multithreaded scheduler requires OS_TASK_AFFINITY_GROUP_LIST
+  #endif
+
+  std::array<worker_group_type, OS_TASK_AFFINITY_GROUP_COUNT> os_worker_groups;
+
+  // The affinity group of the calling worker thread.
+  thread_local worker_group_type* os_worker_group;
+
+  void worker_group_wait(worker_group_type& group, const os::tick_type& wait_ticks)
+  {
+    // Block the worker thread until the wait time has elapsed
+    // or an event has been set for one of the tasks of its group.
+    // The wait time is limited, since it is the maximum tick when no
+    // timer is armed (which would overflow the microseconds).
+    const std::chrono::microseconds wait_time_limit(std::chrono::hours(1));
+
+    const os::tick_type wait_microseconds =
+      (std::min)(os::tick_type(wait_ticks / os::timer_type::microseconds(1U)),
+                 os::tick_type(wait_time_limit.count()));
+
+    std::unique_lock<std::mutex> lock(group.wakeup_mutex);
+
+    group.is_waiting.store(true);
+
+    static_cast<void>(group.wakeup_condition.wait_for(lock,
+                                                      std::chrono::microseconds(wait_microseconds),
+                                                      [&group]() -> bool
+                                                      {
+                                                        return group.wakeup_is_pending.load();
+                                                      }));
+
+    group.is_waiting.store(false);
+
+    group.wakeup_is_pending.store(false);
+  }
+
+  void worker_group_wakeup(worker_group_type& group)
+  {
+    group.wakeup_is_pending.store(true);
+
+    // Take the lock and notify only if the worker thread is actually
+    // waiting, as in mcal::cpu::wakeup, so that setting an event
+    // for a busy group costs no lock traffic.
+    if(group.is_waiting.load())
+    {
+      {
+        const std::lock_guard<std::mutex> lock(group.wakeup_mutex);
+      }
+
+      group.wakeup_condition.notify_one();
+    }
+  }
+
+  #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE)
+
+  typedef os::cyclic_schedule<os::task_table_type> cyclic_schedule_type;
+
+  static_assert(os::task_table_type::cyclic_count() == OS_TASK_COUNT,
+                "the cyclic executive requires all tasks to be cyclic");
+
+  static_assert(   (OS_TASK_COUNT <= std::size_t(UINT8_C(0xFF)))
+                && (os::task_table_type::frame_entry_count() <= std::size_t(UINT16_C(0xFFFF))),
+                "the schedule of the cyclic executive is too large");
+
+  // A minor frame whose tasks exceed it delays the following frames,
+  // which then run back to back, and the jitter is no longer bounded.
+  static_assert(os::task_table_type::frame_budget_max() <= os::task_table_type::minor_frame(),
+                "the budgets of the tasks of a minor frame must not exceed the minor frame");
+
+  // The timer of the next minor frame.
+  os::timer_type os_cyclic_frame_timer;
+
+  #endif
+
+  #if (OS_TRACE == 1)
+  std::uint_fast8_t get_thread_index()
+  {
+    // The trace shows each worker thread of the multithreaded
+    // scheduler as a thread of its own.
+    #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+    return ((os_worker_group != nullptr) ? static_cast<std::uint_fast8_t>(os_worker_group - os_worker_groups.data())
+                                         : std::uint_fast8_t(0U));
+    #else
+    return std::uint_fast8_t(0U);
+    #endif
+  }
+  #endif
+
+  void idle_task_func()
+  {
+    #if (OS_TRACE == 1)
+    os::trace::record(os::trace::record_idle_begin, std::uint_fast16_t(OS_TASK_COUNT), get_thread_index());
+
+    OS_IDLE_TASK_FUNC();
+
+    os::trace::record(os::trace::record_idle_end, std::uint_fast16_t(OS_TASK_COUNT), get_thread_index());
+    #else
+    OS_IDLE_TASK_FUNC();
+    #endif
+  }
 }
 
+#if (OS_TRACE == 1)
+void os::trace::record_running_task(const record_kind_type kind, const event_type value)
+{
+  record(kind, std::uint_fast16_t(os_task_index), get_thread_index(), value);
+}
+#endif
+
 void os::start_os()
 {
   // Initialize each task once (and only once) before the task scheduling begins.
@@ -37,58 +300,445 @@ void os::start_os()
 
   static_cast<void>(it_init_func);
 
+  #if (OS_TRACE == 1)
+  // Register the writing of the trace at exit.
+  trace::initialize();
+  #endif
+
   // Initialize the idle task.
   OS_IDLE_TASK_INIT();
 
+  // Dispatch the first ready task of the task pool, if there is such
+  // a task. The tasks of the pool have a lower priority than the tasks
+  // of the task list, and they are run by the scheduler thread only.
+  static const auto dispatch_pool_task =
+    [](const os::tick_type& timepoint_of_ckeck_ready) -> bool
+    {
+      bool task_is_ready = false;
+
+      #if (OS_TASK_POOL_SIZE > 0U)
+      task_pool_purge();
+
+      for(task_index_type position = 0U; ((position < os_task_pool_active_count) && (task_is_ready == false)); ++position)
+      {
+        os_task_index = task_index_type(OS_TASK_COUNT + os_task_pool_active_list[position]);
+
+        task_is_ready = get_task_pool_control_block(os_task_pool_active_list[position]).execute(timepoint_of_ckeck_ready);
+      }
+
+      if(task_is_ready == false)
+      {
+        os_task_index = task_index_none;
+      }
+      #else
+      static_cast<void>(timepoint_of_ckeck_ready);
+      #endif
+
+      return task_is_ready;
+    };
+
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+
+  // Partition the task list into the affinity groups. Within each
+  // group, the event-triggered tasks are entered ahead of the cyclic
+  // tasks, each in the order of the task list.
+  for(const task_activation_type activation : { task_activation_event, task_activation_cyclic })
+  {
+    for(task_index_type index = 0U; index < task_index_type(OS_TASK_COUNT); ++index)
+    {
+      worker_group_type& group = os_worker_groups[os::detail::task_affinity_group_list[index]];
+
+      if(os_task_list[index].my_activation == activation)
+      {
+        group.task_list[group.task_count] = index;
+
+        ++group.task_count;
+      }
+    }
+  }
+
+  // Run the tasks of one affinity group in the calling thread.
+  const auto worker_func =
+    [](const std::size_t group_index)
+    {
+      os_worker_group = &os_worker_groups[group_index];
+
+      for(;;)
+      {
+        if(group_index == 0U)
+        {
+          // The first group calls the deferred work ahead of its tasks.
+          os_deferred_queue.drain();
+        }
+
+        const os::tick_type timepoint_of_ckeck_ready = os::timer_type::get_mark();
+
+        // Find the next ready task of the group using the linear search.
+        bool task_is_ready = false;
+
+        for(task_index_type position = 0U; ((position < os_worker_group->task_count) && (task_is_ready == false)); ++position)
+        {
+          os_task_index = os_worker_group->task_list[position];
+
+          task_control_block& the_tcb = os_task_list[os_task_index];
+
+          task_is_ready = ((the_tcb.my_activation == task_activation_event)
+                            ? the_tcb.execute_event_triggered(timepoint_of_ckeck_ready)
+                            : the_tcb.execute(timepoint_of_ckeck_ready));
+        }
+
+        if(task_is_ready == false)
+        {
+          if(group_index == 0U)
+          {
+            // The first group services the task pool and the idle task.
+            if(dispatch_pool_task(timepoint_of_ckeck_ready) == false)
+            {
+              idle_task_func();
+            }
+          }
+          else
+          {
+            // The other groups wait for their next task.
+            worker_group_wait(*os_worker_group, os::get_ticks_until_next_task());
+          }
+        }
+      }
+    };
+
+  // Start the worker threads of the other affinity groups.
+  for(std::size_t group_index = 1U; group_index < std::size_t(OS_TASK_AFFINITY_GROUP_COUNT); ++group_index)
+  {
+    std::thread(worker_func, group_index).detach();
+  }
+
+  // Run the first affinity group in this thread and never return.
+  worker_func(0U);
+
+  #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE)
+
+  std::size_t frame = 0U;
+
+  // Begin the first minor frame now.
+  os_cyclic_frame_timer.start_relative(os::tick_type(0U));
+
+  // Enter the endless loop of the cyclic executive...
+  // ...and never return.
+  for(;;)
+  {
+    // Call the deferred work ahead of the tasks.
+    os_deferred_queue.drain();
+
+    if(os_cyclic_frame_timer.timeout())
+    {
+      #if (OS_TASK_PROFILING == 1)
+      const os::timer_type frame_start(os_cyclic_frame_timer);
+      #endif
+
+      // Advance the frame timer by one minor frame. A minor frame
+      // that overruns delays the following ones, which then run back
+      // to back until the schedule has caught up with its phase.
+      os_cyclic_frame_timer.start_interval(os::tick_type(os::task_table_type::minor_frame()));
+
+      // Call the tasks of the minor frame.
+      for(std::size_t entry  = cyclic_schedule_type::frame_begins[frame];
+                      entry != cyclic_schedule_type::frame_begins[frame + 1U];
+                    ++entry)
+      {
+        os_task_index = static_cast<task_index_type>(cyclic_schedule_type::frame_entries[entry]);
+
+        #if (OS_TASK_PROFILING == 1)
+        // The lateness of a task is measured from the start of its minor frame.
+        os_task_list[os_task_index].my_statistics.record_activation(frame_start.get_ticks_since_timeout(os::timer_type::get_mark()));
+        #endif
+
+        os_task_list[os_task_index].call_func();
+      }
+
+      ++frame;
+
+      if(frame == os::task_table_type::frame_count())
+      {
+        frame = 0U;
+      }
+    }
+    else if(dispatch_pool_task(os::timer_type::get_mark()) == false)
+    {
+      // If the next minor frame is not due and no task of the
+      // task pool is ready, then service the idle task.
+      idle_task_func();
+    }
+  }
+
+  #else
+
+  // Collect the event-triggered tasks in the order of the task list.
+  for(task_index_type index = 0U; index < task_index_type(OS_TASK_COUNT); ++index)
+  {
+    if(os_task_list[index].my_activation == task_activation_event)
+    {
+      os_event_task_list[os_event_task_count] = index;
+
+      ++os_event_task_count;
+    }
+  }
+
+  // Dispatch the highest-priority event-triggered task that has
+  // an activating event or a timeout, if there is such a task.
+  const auto dispatch_event_triggered_task =
+    [](const os::tick_type& timepoint_of_ckeck_ready) -> bool
+    {
+      bool task_is_ready = false;
+
+      for(task_index_type position = 0U; ((position < os_event_task_count) && (task_is_ready == false)); ++position)
+      {
+        os_task_index = os_event_task_list[position];
+
+        task_is_ready = os_task_list[os_task_index].execute_event_triggered(timepoint_of_ckeck_ready);
+      }
+
+      return task_is_ready;
+    };
+
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+
+  // Enter each cyclic task into the timer heap of the ready queue.
+  for(task_index_type index = 0U; index < task_index_type(OS_TASK_COUNT); ++index)
+  {
+    if(   (os_task_list[index].my_activation == task_activation_cyclic)
+       && (os_task_list[index].my_cycle != os::tick_type(0U)))
+    {
+      os_ready_queue.push_timer(index);
+    }
+  }
+
   // Enter the endless loop of the multitasking scheduler...
   // ...and never return.
   for(;;)
   {
-    // Find the next ready task using a priority-based search algorithm.
+    // Call the deferred work ahead of the tasks.
+    os_deferred_queue.drain();
+
+    // Use a constant time-point based on the timer mark of now,
+    // as in the linear search below.
+
+    const os::tick_type timepoint_of_ckeck_ready = os::timer_type::get_mark();
+
+    // Dispatch the event-triggered tasks ahead of the cyclic tasks.
+    if(dispatch_event_triggered_task(timepoint_of_ckeck_ready) == false)
+    {
+      // Move every task whose timer has expired from the timer heap
+      // to the ready heap.
+      while(os_ready_queue.timer_is_due(timepoint_of_ckeck_ready))
+      {
+        os_ready_queue.push_ready(os_ready_queue.pop_timer(),
+                                  ready_queue_type::ready_reason_timer);
+      }
+
+      // Move every cyclic task that has received an event to the ready heap.
+      if(event_pending_flag_take())
+      {
+        for(task_index_type index = 0U; index < task_index_type(OS_TASK_COUNT); ++index)
+        {
+          if(   (os_task_list[index].my_activation == task_activation_cyclic)
+             && (os_task_list[index].get_event_relaxed() != os::event_type(0U)))
+          {
+            os_ready_queue.push_ready(index, ready_queue_type::ready_reason_event);
+          }
+        }
+      }
+
+      if(os_ready_queue.ready_is_empty())
+      {
+        // If no task is ready, then service the task pool
+        // or (if no task of the pool is ready) the idle task.
+        if(dispatch_pool_task(timepoint_of_ckeck_ready) == false)
+        {
+          idle_task_func();
+        }
+      }
+      else
+      {
+        // Dispatch the ready task having the highest priority.
+        std::uint_fast8_t reasons;
+
+        os_task_index = static_cast<task_index_type>(os_ready_queue.pop_ready(reasons));
+
+        task_control_block& the_tcb = os_task_list[os_task_index];
+
+        if((reasons & std::uint_fast8_t(ready_queue_type::ready_reason_timer)) != 0U)
+        {
+          // Increment the task's interval timer with the task cycle
+          // and re-enter the task into the timer heap.
+          the_tcb.start_next_interval(timepoint_of_ckeck_ready);
+
+          os_ready_queue.push_timer(os_task_index);
+        }
+
+        // Call the task function. Note that simultaneous activations
+        // from an event and from a timeout result in one single call.
+        the_tcb.call_func();
+
+        // A task whose event has not been cleared remains ready.
+        if(the_tcb.get_event_relaxed() != os::event_type(0U))
+        {
+          os_ready_queue.push_ready(os_task_index, ready_queue_type::ready_reason_event);
+        }
+      }
+    }
+  }
+
+  #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_EDF)
+
+  // Enter the endless loop of the multitasking scheduler...
+  // ...and never return.
+  for(;;)
+  {
+    // Call the deferred work ahead of the tasks.
+    os_deferred_queue.drain();
+
+    const os::tick_type timepoint_of_ckeck_ready = os::timer_type::get_mark();
+
+    // Dispatch the event-triggered tasks ahead of the cyclic tasks.
+    if(dispatch_event_triggered_task(timepoint_of_ckeck_ready) == false)
+    {
+      // Find the ready cyclic task having the earliest deadline.
+      // Of tasks with equal deadlines, the first in the task list wins.
+      task_index_type index_of_earliest = task_index_type(OS_TASK_COUNT);
+      os::tick_type   key_of_earliest   = os::tick_type(0U);
+
+      for(task_index_type index = 0U; index < task_index_type(OS_TASK_COUNT); ++index)
+      {
+        const task_control_block& the_tcb = os_task_list[index];
+
+        if(   (the_tcb.my_activation == task_activation_cyclic)
+           && (the_tcb.get_ticks_until_ready(timepoint_of_ckeck_ready) == os::tick_type(0U)))
+        {
+          const os::tick_type key = the_tcb.get_deadline_key(timepoint_of_ckeck_ready);
+
+          if((index_of_earliest == task_index_type(OS_TASK_COUNT)) || (key < key_of_earliest))
+          {
+            index_of_earliest = index;
+            key_of_earliest   = key;
+          }
+        }
+      }
+
+      if(index_of_earliest != task_index_type(OS_TASK_COUNT))
+      {
+        os_task_index = index_of_earliest;
+
+        static_cast<void>(os_task_list[os_task_index].execute(timepoint_of_ckeck_ready));
+      }
+      else if(dispatch_pool_task(timepoint_of_ckeck_ready) == false)
+      {
+        // If no ready-task was found, then service the task pool
+        // or (if no task of the pool is ready) the idle task.
+        idle_task_func();
+      }
+    }
+  }
+
+  #else
+
+  // Enter the endless loop of the multitasking scheduler...
+  // ...and never return.
+  for(;;)
+  {
+    // Call the deferred work ahead of the tasks.
+    os_deferred_queue.drain();
+
     // Use a constant time-point based on the timer mark of now.
     // In this way, each task in the loop will be checked for being
     // ready using the same time-point.
 
     const os::tick_type timepoint_of_ckeck_ready = os::timer_type::get_mark();
 
-    os_task_index = static_cast<task_index_type>(0U);
+    // Dispatch the event-triggered tasks ahead of the cyclic tasks.
+    if(dispatch_event_triggered_task(timepoint_of_ckeck_ready) == false)
+    {
+      // Find the next ready task using a priority-based search algorithm.
 
-    const auto it_ready_task =
-      std::find_if(os_task_list.begin(),
-                   os_task_list.end(),
-                   [&timepoint_of_ckeck_ready](task_control_block& tcb) -> bool
-                   {
-                     const bool task_is_ready = tcb.execute(timepoint_of_ckeck_ready);
+      os_task_index = static_cast<task_index_type>(0U);
 
-                     ++os_task_index;
+      const auto it_ready_task =
+        std::find_if(os_task_list.begin(),
+                     os_task_list.end(),
+                     [&timepoint_of_ckeck_ready](task_control_block& tcb) -> bool
+                     {
+                       const bool task_is_ready = tcb.execute(timepoint_of_ckeck_ready);
 
-                     return task_is_ready;
-                   });
+                       ++os_task_index;
 
-    // If no ready-task was found, then service the idle task.
-    if(it_ready_task == os_task_list.end())
-    {
-      OS_IDLE_TASK_FUNC();
+                       return task_is_ready;
+                     });
+
+      // If no ready-task was found, then service the task pool
+      // or (if no task of the pool is ready) the idle task.
+      if(   (it_ready_task == os_task_list.end())
+         && (dispatch_pool_task(timepoint_of_ckeck_ready) == false))
+      {
+        idle_task_func();
+      }
     }
   }
+
+  #endif
+
+  #endif
 }
 
 bool os::set_event(const task_id_type task_id, const event_type& event_to_set)
 {
-  if(task_id < task_id_end)
+  // Get the control block corresponding to the task id
+  // that has been supplied to this subroutine.
+  task_control_block* it_task_id = get_task_control_block(std::size_t(task_id));
+
+  if(it_task_id != nullptr)
   {
-    // Get the iterator of the control block corresponding to
-    // the task id that has been supplied to this subroutine.
-    const auto it_task_id = (  os_task_list.begin()
-                             + task_list_type::size_type(task_id));
 
     // Set the event of the corresponding task.
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+
+    static_cast<void>(__atomic_fetch_or(&it_task_id->my_event, event_to_set, __ATOMIC_RELEASE));
+
+    #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+    __atomic_store_n(&os_event_is_pending, true, __ATOMIC_SEQ_CST);
+    #endif
+
+    #else
+
     mcal::irq::disable_all();
 
     it_task_id->my_event |= event_to_set;
 
+    #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+    os_event_is_pending = true;
+    #endif
+
     mcal::irq::enable_all();
 
+    #endif
+
+    #if (OS_TRACE == 1)
+    trace::record(trace::record_event_set, std::uint_fast16_t(task_id), get_thread_index(), event_to_set);
+    #endif
+
+    // Wake up the idle task if it is waiting for the next task.
+    mcal::cpu::wakeup();
+
+    #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+    // Wake up the worker thread of the task's affinity group. The tasks
+    // of the task pool run in the first group, whose worker thread is
+    // the one of the idle task, which has just been woken up above.
+    const std::uint_fast8_t group_index = ((task_id < task_id_end) ? os::detail::task_affinity_group_list[task_id] : 0U);
+
+    if(group_index != 0U)
+    {
+      worker_group_wakeup(os_worker_groups[group_index]);
+    }
+    #endif
+
     return true;
   }
   else
@@ -99,18 +749,26 @@ bool os::set_event(const task_id_type task_id, const event_type& event_to_set)
 
 void os::get_event(event_type& event_to_get)
 {
-  // Get the iterator of the control block of the running task.
-  const auto it_running_task = (os_task_list.cbegin() + os_task_index);
+  // Get the control block of the running task.
+  const task_control_block* it_running_task = get_task_control_block(os_task_index);
 
-  if(it_running_task != os_task_list.cend())
+  if(it_running_task != nullptr)
   {
     // Get the event of the running task.
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+
+    const event_type the_event = __atomic_load_n(&it_running_task->my_event, __ATOMIC_ACQUIRE);
+
+    #else
+
     mcal::irq::disable_all();
 
     const volatile event_type the_event = it_running_task->my_event;
 
     mcal::irq::enable_all();
 
+    #endif
+
     event_to_get = the_event;
   }
   else
@@ -121,18 +779,240 @@ void os::get_event(event_type& event_to_get)
 
 void os::clear_event(const event_type& event_to_clear)
 {
-  // Get the iterator of the control block of the running task.
-  const auto it_running_task = (os_task_list.begin() + os_task_index);
+  // Get the control block of the running task.
+  task_control_block* it_running_task = get_task_control_block(os_task_index);
 
-  if(it_running_task != os_task_list.end())
+  if(it_running_task != nullptr)
   {
     const volatile event_type event_clear_mask(~event_to_clear);
 
     // Clear the event of the running task.
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+
+    static_cast<void>(__atomic_fetch_and(&it_running_task->my_event, event_type(event_clear_mask), __ATOMIC_ACQ_REL));
+
+    #else
+
     mcal::irq::disable_all();
 
     it_running_task->my_event &= event_clear_mask;
 
     mcal::irq::enable_all();
+
+    #endif
+
+    #if (OS_TRACE == 1)
+    trace::record_running_task(trace::record_event_clear, event_to_clear);
+    #endif
+  }
+}
+
+void os::wait_event(const event_type& event_mask, const tick_type& timeout)
+{
+  // Get the control block of the running task.
+  task_control_block* it_running_task = get_task_control_block(os_task_index);
+
+  if(   (it_running_task != nullptr)
+     && (it_running_task->my_activation == task_activation_event))
+  {
+    // Activate the running event-triggered task again when one of
+    // the events in the mask is set, or at the latest when the timeout
+    // expires. A timeout of zero waits for the events without a timeout.
+    it_running_task->my_wait_mask             = event_mask;
+    it_running_task->my_wait_is_pending       = true;
+    it_running_task->my_wait_timeout_is_armed = (timeout != tick_type(0U));
+
+    if(it_running_task->my_wait_timeout_is_armed)
+    {
+      it_running_task->my_timer.start_relative(timeout);
+    }
+  }
+}
+
+os::tick_type os::get_ticks_until_next_task()
+{
+  // Obtain the number of ticks until the next task becomes ready.
+  // This is zero if a task (or deferred work) is ready now, and it is the maximum
+  // tick value if no task has an armed timer.
+
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+  const bool deferred_work_is_pending = ((os_worker_group == &os_worker_groups[0U]) && (os_deferred_queue.is_empty() == false));
+  #else
+  const bool deferred_work_is_pending = (os_deferred_queue.is_empty() == false);
+  #endif
+
+  if(deferred_work_is_pending)
+  {
+    return os::tick_type(0U);
+  }
+
+  const os::tick_type timepoint_of_ckeck_ready = os::timer_type::get_mark();
+
+  os::tick_type ticks_until_next_task = (std::numeric_limits<os::tick_type>::max)();
+
+  // Consider the tasks of the task pool, which run in the scheduler thread.
+  #if (OS_TASK_POOL_SIZE > 0U)
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+  if(os_worker_group == &os_worker_groups[0U])
+  #endif
+  {
+    for(task_index_type position = 0U; position < os_task_pool_active_count; ++position)
+    {
+      const task_index_type slot = os_task_pool_active_list[position];
+
+      if(os_task_pool_retire_is_pending[slot] == false)
+      {
+        ticks_until_next_task =
+          (std::min)(ticks_until_next_task,
+                     get_task_pool_control_block(slot).get_ticks_until_ready(timepoint_of_ckeck_ready));
+      }
+    }
+  }
+  #endif
+
+  #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+
+  const bool task_is_ready = (os_event_is_pending || (os_ready_queue.ready_is_empty() == false));
+
+  ticks_until_next_task =
+    (task_is_ready ? os::tick_type(0U)
+                   : (std::min)(ticks_until_next_task, os_ready_queue.get_ticks_until_due(timepoint_of_ckeck_ready)));
+
+  for(task_index_type position = 0U; position < os_event_task_count; ++position)
+  {
+    ticks_until_next_task =
+      (std::min)(ticks_until_next_task,
+                 os_task_list[os_event_task_list[position]].get_ticks_until_ready(timepoint_of_ckeck_ready));
+  }
+
+  return ticks_until_next_task;
+
+  #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE)
+
+  // The next task of the task list runs at the beginning of the next minor frame.
+  return (std::min)(ticks_until_next_task, os_cyclic_frame_timer.get_ticks_until_timeout(timepoint_of_ckeck_ready));
+
+  #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_MULTITHREAD)
+
+  // Consider the tasks of the calling worker thread's affinity group.
+  const task_index_type task_count = ((os_worker_group != nullptr) ? os_worker_group->task_count : task_index_type(0U));
+
+  for(task_index_type position = 0U; ((position < task_count) && (ticks_until_next_task != os::tick_type(0U))); ++position)
+  {
+    ticks_until_next_task =
+      (std::min)(ticks_until_next_task,
+                 os_task_list[os_worker_group->task_list[position]].get_ticks_until_ready(timepoint_of_ckeck_ready));
+  }
+
+  return ticks_until_next_task;
+
+  #else
+
+  for(const task_control_block& tcb : os_task_list)
+  {
+    ticks_until_next_task =
+      (std::min)(ticks_until_next_task,
+                 tcb.get_ticks_until_ready(timepoint_of_ckeck_ready));
+
+    if(ticks_until_next_task == os::tick_type(0U))
+    {
+      break;
+    }
+  }
+
+  return ticks_until_next_task;
+
+  #endif
+}
+
+bool os::post_deferred_work(const deferred_function_type function, const std::uintptr_t payload)
+{
+  const bool work_is_posted = os_deferred_queue.push(function, payload);
+
+  if(work_is_posted)
+  {
+    // Wake up the idle task if it is waiting for the next task.
+    mcal::cpu::wakeup();
+  }
+
+  return work_is_posted;
+}
+
+bool os::spawn_task(const function_type init,
+                    const function_type func,
+                    const tick_type& cycle,
+                    const tick_type& offset,
+                    task_id_type& task_id)
+{
+  // Take the first free slot of the task pool (if there is one)
+  // and construct the control block of the new task in it.
+  const auto it_free_slot = std::find(os_task_pool_slot_is_used.begin(),
+                                      os_task_pool_slot_is_used.end(),
+                                      false);
+
+  if(it_free_slot != os_task_pool_slot_is_used.end())
+  {
+    const task_index_type slot = static_cast<task_index_type>(std::distance(os_task_pool_slot_is_used.begin(), it_free_slot));
+
+    task_control_block* the_tcb = new(os_task_pool[slot].storage) task_control_block(init, func, cycle, offset);
+
+    *it_free_slot = true;
+
+    the_tcb->initialize();
+
+    os_task_pool_active_list[os_task_pool_active_count] = slot;
+
+    ++os_task_pool_active_count;
+
+    task_id = static_cast<task_id_type>(OS_TASK_COUNT + slot);
+
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+bool os::retire_task(const task_id_type task_id)
+{
+  const std::size_t index = std::size_t(task_id);
+
+  // Only the tasks of the task pool can be retired. The retired task
+  // is removed from the scheduler before its next activation.
+  if(   (index >= OS_TASK_COUNT)
+     && (get_task_control_block(index) != nullptr))
+  {
+    os_task_pool_retire_is_pending[index - OS_TASK_COUNT] = true;
+
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+bool os::retire_task()
+{
+  return retire_task(static_cast<task_id_type>(os_task_index));
+}
+
+#if (OS_TASK_PROFILING == 1)
+bool os::get_task_statistics(const task_id_type task_id, task_statistics& statistics_to_get)
+{
+  const task_control_block* the_tcb = get_task_control_block(std::size_t(task_id));
+
+  if(the_tcb != nullptr)
+  {
+    // Get a copy of the statistics of the task with the supplied task id.
+    statistics_to_get = the_tcb->my_statistics;
+
+    return true;
+  }
+  else
+  {
+    return false;
   }
 }
+#endif
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2016.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -11,6 +11,8 @@
   #include <cstdint>
   #include <limits>
   #include <os/os_cfg.h>
+  #include <os/os_deferred_queue.h>
+  #include <os/os_task_statistics.h>
   #include <util/utility/util_time.h>
 
   namespace os
@@ -19,6 +21,35 @@
     bool set_event  (const task_id_type task_id, const event_type& event_to_set);
     void get_event  (event_type& event_to_get);
     void clear_event(const event_type& event_to_clear);
+    void wait_event (const event_type& event_mask, const tick_type& timeout);
+
+    tick_type get_ticks_until_next_task();
+
+    // Defer work from an interrupt service routine to the scheduler,
+    // which calls the function with the payload ahead of all tasks.
+    // This returns false if the queue of deferred work is full.
+    bool post_deferred_work(const deferred_function_type function, const std::uintptr_t payload = 0U);
+
+    // Spawn a task at runtime in a free slot of the task pool (see
+    // OS_TASK_POOL_SIZE). The task is initialized at once. It is activated
+    // after the offset and then with its cycle (a cycle of zero activates
+    // it by its events only), at a lower priority than the task list.
+    // This returns false if the pool is full, otherwise the task id.
+    bool spawn_task(const function_type init,
+                    const function_type func,
+                    const tick_type& cycle,
+                    const tick_type& offset,
+                    task_id_type& task_id);
+
+    // Retire a spawned task (or, without an argument, the running task)
+    // and free its slot of the task pool. Call these and spawn_task
+    // in the scheduler thread, from a task or from the idle task.
+    bool retire_task(const task_id_type task_id);
+    bool retire_task();
+
+    #if (OS_TASK_PROFILING == 1)
+    bool get_task_statistics(const task_id_type task_id, task_statistics& statistics_to_get);
+    #endif
   }
 
 #endif // OS_2011_10_20_H_
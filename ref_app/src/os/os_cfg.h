@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2016.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -12,8 +12,118 @@
   #include <cstdint>
   #include <limits>
 
+  #include <os/os_task_table.h>
   #include <util/utility/util_time.h>
 
+  // Select the algorithm that the scheduler uses to find the next ready task.
+  //   LINEAR      : Check every task in the task list on each scheduler pass.
+  //   READY_QUEUE : Keep the tasks in deadline-ordered and priority-ordered
+  //                 heaps, so that the next ready task is found in O(log n)
+  //                 and a scheduler pass with nothing due costs one comparison.
+  // In both cases the task priority is given by the position in the task list.
+  //   MULTITHREAD : (Host only) Run each task affinity group (see below)
+  //                 in its own worker thread using the linear search.
+  //                 Each task runs in one thread only, so its calls are
+  //                 sequential. The event API is available across groups.
+  //   CYCLIC_EXECUTIVE : Run the cyclic tasks from a static schedule of
+  //                 minor frames that is generated from the task table
+  //                 at compile time (see os_task_table.h). Each minor frame
+  //                 calls its list of tasks without checking any task timers.
+  //                 All tasks must be cyclic, and events do not activate
+  //                 tasks (but they can be polled with get_event).
+  //                 The budgets of the tasks released in a minor frame
+  //                 must fit into the minor frame (checked at compile time).
+  //   EDF         : Dispatch the event-triggered tasks first (as in LINEAR),
+  //                 then the ready cyclic task having the earliest deadline,
+  //                 which is its timeout plus its cycle. Tasks with equal
+  //                 deadlines are dispatched in the order of the task list.
+  #define OS_SCHEDULER_TYPE_LINEAR             0
+  #define OS_SCHEDULER_TYPE_READY_QUEUE        1
+  #define OS_SCHEDULER_TYPE_MULTITHREAD        2
+  #define OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE   3
+  #define OS_SCHEDULER_TYPE_EDF                4
+
+  #if !defined(OS_SCHEDULER_TYPE)
+  #define OS_SCHEDULER_TYPE   OS_SCHEDULER_TYPE_LINEAR
+  //#define OS_SCHEDULER_TYPE   OS_SCHEDULER_TYPE_READY_QUEUE
+  //#define OS_SCHEDULER_TYPE   OS_SCHEDULER_TYPE_MULTITHREAD
+  //#define OS_SCHEDULER_TYPE   OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE
+  //#define OS_SCHEDULER_TYPE   OS_SCHEDULER_TYPE_EDF
+  #endif
+
+  // Enable (1) or disable (0) the per-task run time and activation
+  // lateness statistics. When disabled, there is no overhead at all.
+  #if !defined(OS_TASK_PROFILING)
+  #define OS_TASK_PROFILING   0
+  //#define OS_TASK_PROFILING   1
+  #endif
+
+  // Enable (1) or disable (0) the trace of the scheduler activity
+  // (task begin and end, event set and clear, idle begin and end).
+  // The trace is recorded in a lock-free ring buffer of OS_TRACE_BUFFER_SIZE
+  // records (a power of two). On the host, it is written as Chrome trace
+  // event JSON to OS_TRACE_FILE_NAME at exit or on SIGINT or SIGTERM.
+  #if !defined(OS_TRACE)
+  #define OS_TRACE   0
+  //#define OS_TRACE   1
+  #endif
+
+  #if !defined(OS_TRACE_BUFFER_SIZE)
+  #define OS_TRACE_BUFFER_SIZE   4096U
+  #endif
+
+  #if !defined(OS_TRACE_FILE_NAME)
+  #define OS_TRACE_FILE_NAME   "ref_app_trace.json"
+  #endif
+
+  // Configure the static pool from which the frames of the coroutine
+  // tasks are allocated (see os/os_coroutine.h, which requires C++20).
+  #if !defined(OS_COROUTINE_FRAME_SIZE)
+  #define OS_COROUTINE_FRAME_SIZE    256U
+  #endif
+
+  #if !defined(OS_COROUTINE_FRAME_COUNT)
+  #define OS_COROUTINE_FRAME_COUNT   2U
+  #endif
+
+  // Configure the number of tasks that can be spawned at runtime
+  // (with os::spawn_task) in addition to the tasks of the task list.
+  #if !defined(OS_TASK_POOL_SIZE)
+  #define OS_TASK_POOL_SIZE   2U
+  #endif
+
+  // Configure the number of work items that interrupt service routines
+  // can defer to the scheduler with os::post_deferred_work (a power of two).
+  // The deferred work is called ahead of all tasks on each scheduler pass.
+  #if !defined(OS_DEFERRED_QUEUE_SIZE)
+  #define OS_DEFERRED_QUEUE_SIZE   8U
+  #endif
+
+  // Select how the task events are accessed by set_event, get_event
+  // and clear_event.
+  //   CRITICAL_SECTION : Bracket each access with mcal::irq::disable_all
+  //                      and mcal::irq::enable_all.
+  //   ATOMIC           : Use lock-free atomic read-modify-write operations
+  //                      (fetch-or and fetch-and) without disabling interrupts.
+  // The atomic access is selected by default on the architectures whose
+  // instruction sets have lock-free read-modify-write operations
+  // for the width of the event_type.
+  #define OS_EVENT_ACCESS_TYPE_CRITICAL_SECTION   0
+  #define OS_EVENT_ACCESS_TYPE_ATOMIC             1
+
+  #if !defined(OS_EVENT_ACCESS_TYPE)
+    #if (   defined(__x86_64__)        \
+         || defined(__i386__)          \
+         || defined(__aarch64__)       \
+         || defined(__ARM_ARCH_7A__)   \
+         || defined(__ARM_ARCH_7M__)   \
+         || defined(__ARM_ARCH_7EM__))
+    #define OS_EVENT_ACCESS_TYPE   OS_EVENT_ACCESS_TYPE_ATOMIC
+    #else
+    #define OS_EVENT_ACCESS_TYPE   OS_EVENT_ACCESS_TYPE_CRITICAL_SECTION
+    #endif
+  #endif
+
   // Declare the task initialization and the task function of the idle process.
   namespace sys { namespace idle { void task_init(); void task_func(); } }
 
@@ -21,6 +131,41 @@
   #define OS_IDLE_TASK_INIT() sys::idle::task_init()
   #define OS_IDLE_TASK_FUNC() sys::idle::task_func()
 
+  namespace os
+  {
+    // Configure the operating system types.
+    typedef void(*function_type)();
+
+    typedef util::timer<std::uint_fast32_t> timer_type;
+    typedef timer_type::tick_type           tick_type;
+    typedef std::uint_fast16_t              event_type;
+
+    // Enumerate the task activation types. Cyclic tasks are activated
+    // by their timer and by their events in the order of the task list.
+    // Event-triggered tasks are dispatched ahead of all cyclic tasks
+    // as soon as they receive an event or their timer expires.
+    typedef enum enum_task_activation_type
+    {
+      task_activation_cyclic,
+      task_activation_event
+    }
+    task_activation_type;
+
+    static_assert(std::numeric_limits<os::tick_type>::digits >= 32,
+                  "The operating system timer_type must be at least 32-bits wide.");
+
+    static_assert(std::numeric_limits<os::event_type>::digits >= 16,
+                  "The operating system event_type must be at least 16-bits wide.");
+  }
+
+  // The task configuration (the task IDs, the task timing table, the task
+  // list and the task affinity groups) can be replaced by a header of its
+  // own, which is named by OS_CFG_TASK_HEADER. The host benchmarks of the
+  // scheduler in tools/benchmark use this for their synthetic task sets.
+  #if defined(OS_CFG_TASK_HEADER)
+  #include OS_CFG_TASK_HEADER
+  #else
+
   // Declare all of the task initializations and the task functions.
   namespace app { namespace led       { void task_init(); void task_func(); } }
   namespace app { namespace benchmark { void task_init(); void task_func(); } }
@@ -30,7 +175,8 @@
   {
     // Enumerate the task IDs. Note that the order in this list must
     // be identical with the order of the tasks in the task list below.
-    typedef enum enum_task_id
+    // The tasks of the task pool have the IDs from task_id_end onward.
+    typedef enum enum_task_id : std::uint_least16_t
     {
       task_id_app_led,
       task_id_app_benchmark,
@@ -38,51 +184,100 @@
       task_id_end
     }
     task_id_type;
+  }
 
-    // Configure the operating system types.
-    typedef void(*function_type)();
-
-    typedef util::timer<std::uint_fast32_t> timer_type;
-    typedef timer_type::tick_type           tick_type;
-    typedef std::uint_fast16_t              event_type;
+  // Configure the timing of the operating system tasks: the cycle and
+  // the declared worst-case execution budget of each task. The order
+  // in this table must be identical with the order of the task list.
+  // The task offsets are computed from the table, so that the cyclic
+  // tasks are never activated at the same tick (see os_task_table.h).
+  // The cyclic executive requires the budgets of each minor frame (of
+  // 2000us here) to fit into the frame. The budget of the benchmark task
+  // does not, so its budget must be reduced (or the benchmark split up)
+  // for the cyclic executive.
+  namespace os
+  {
+    typedef task_table<task_timing<timer_type::microseconds(UINT32_C( 2000)), timer_type::microseconds(UINT32_C( 100))>,
+                       task_timing<timer_type::microseconds(UINT32_C(10000)), timer_type::microseconds(UINT32_C(5000))>,
+                       task_timing<timer_type::microseconds(UINT32_C( 4000)), timer_type::microseconds(UINT32_C( 200))>>
+    task_table_type;
+  }
 
-    static_assert(std::numeric_limits<os::tick_type>::digits >= 32,
-                  "The operating system timer_type must be at least 32-bits wide.");
+  // Configure the operating system tasks.
 
-    static_assert(std::numeric_limits<os::event_type>::digits >= 16,
-                  "The operating system event_type must be at least 16-bits wide.");
+  #define OS_TASK_LIST                                                                                \
+  {                                                                                                   \
+    {                                                                                                 \
+      os::task_control_block(app::led::task_init,                                                     \
+                             app::led::task_func,                                                     \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_app_led)),         \
+                             os::tick_type(os::task_table_type::offset(os::task_id_app_led))),        \
+      os::task_control_block(app::benchmark::task_init,                                               \
+                             app::benchmark::task_func,                                               \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_app_benchmark)),   \
+                             os::tick_type(os::task_table_type::offset(os::task_id_app_benchmark))),  \
+      os::task_control_block(sys::mon::task_init,                                                     \
+                             sys::mon::task_func,                                                     \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_sys_mon)),         \
+                             os::tick_type(os::task_table_type::offset(os::task_id_sys_mon))),        \
+    }                                                                                                 \
   }
 
-  // Configure the operating system tasks.
+  // Configure the task affinity groups of the multithreaded scheduler.
+  // Each group is run by its own worker thread. Group 0 is run in the
+  // thread that calls start_os, together with the idle task. The order
+  // in this list must be identical with the order of the tasks in the
+  // task list above.
+  #define OS_TASK_AFFINITY_GROUP_COUNT 2U
+
+  #define OS_TASK_AFFINITY_GROUP_LIST { 0U, 1U, 0U }
 
-  // Use small prime numbers (representing microseconds) for task offsets.
-  // Use Wolfram's Alpha or Mathematica(R): Table[Prime[n], {n, 25, 1000, 25}]
-  // to obtain:
-  //    97,  229,  379,  541,  691,  863, 1039, 1223, 1427, 1583, 1777,
-  //  1987, 2153, 2357, 2557, 2741, 2953, 3181, 3371, 3571, 3769, 3989,
-  //  4201, 4409, 4637, 4831, 5039, 5279, 5483, 5693, 5881, 6133, 6337,
-  //  6571, 6793, 6997, 7237, 7499, 7687, 7919
+  #endif // OS_CFG_TASK_HEADER
 
   #define OS_TASK_COUNT static_cast<std::size_t>(os::task_id_end)
 
-  #define OS_TASK_LIST                                                                           \
-  {                                                                                              \
-    {                                                                                            \
-      os::task_control_block(app::led::task_init,                                                \
-                             app::led::task_func,                                                \
-                             os::timer_type::microseconds(UINT32_C(  2000)),                     \
-                             os::timer_type::microseconds(UINT32_C(     0))),                    \
-      os::task_control_block(app::benchmark::task_init,                                          \
-                             app::benchmark::task_func,                                          \
-                             os::timer_type::microseconds(UINT32_C( 10000)),                     \
-                             os::timer_type::microseconds(UINT32_C(   379))),                    \
-      os::task_control_block(sys::mon::task_init,                                                \
-                             sys::mon::task_func,                                                \
-                             os::timer_type::microseconds(UINT32_C(  4000)),                     \
-                             os::timer_type::microseconds(UINT32_C(   541))),                    \
-    }                                                                                            \
+  static_assert(OS_TASK_COUNT > std::size_t(0U), "the task count must exceed zero");
+
+  static_assert(os::task_table_type::size() == OS_TASK_COUNT,
+                "the size of the task table must equal the task count");
+
+  static_assert(os::task_table_type::budgets_are_within_cycles(),
+                "the worst-case execution budget of a task exceeds its cycle");
+
+  static_assert(os::task_table_type::utilization_permille() <= UINTMAX_C(1000),
+                "the utilization of the cyclic tasks exceeds 100 percent");
+
+  static_assert(os::task_table_type::hyperperiod() <= std::uintmax_t((std::numeric_limits<os::tick_type>::max)() / 2U),
+                "the hyperperiod of the tasks exceeds the range of the timer");
+
+  // The task affinity groups are only needed by the multithreaded
+  // scheduler, and a task configuration header may omit them.
+  #if defined(OS_TASK_AFFINITY_GROUP_LIST)
+
+  namespace os
+  {
+    namespace detail
+    {
+      constexpr std::uint_fast8_t task_affinity_group_list[] = OS_TASK_AFFINITY_GROUP_LIST;
+
+      constexpr std::size_t task_affinity_group_list_size = sizeof(task_affinity_group_list) / sizeof(task_affinity_group_list[0U]);
+
+      constexpr bool task_affinity_groups_are_valid(const std::size_t index = 0U)
+      {
+        return ((index == task_affinity_group_list_size)
+                 ? true
+                 : (   (task_affinity_group_list[index] < std::uint_fast8_t(OS_TASK_AFFINITY_GROUP_COUNT))
+                    && task_affinity_groups_are_valid(index + 1U)));
+      }
+    }
   }
 
-  static_assert(OS_TASK_COUNT > std::size_t(0U), "the task count must exceed zero");
+  static_assert(os::detail::task_affinity_group_list_size == OS_TASK_COUNT,
+                "the task affinity group list must have one entry per task");
+
+  static_assert(os::detail::task_affinity_groups_are_valid(),
+                "a task affinity group exceeds the task affinity group count");
+
+  #endif // OS_TASK_AFFINITY_GROUP_LIST
 
 #endif // OS_CFG_2011_10_20_H_
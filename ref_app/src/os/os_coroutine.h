@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef OS_COROUTINE_2020_10_17_H_
+  #define OS_COROUTINE_2020_10_17_H_
+
+  // Stackless coroutine tasks for the cooperative scheduler (C++20).
+  // A coroutine task is a function returning os::coroutine_task.
+  // It is resumed once per activation of its task, and it yields
+  // with one of the following:
+  //   co_await os::next_cycle()  : Continue on the next activation.
+  //   co_await os::delay(ticks)  : Continue on the first activation
+  //                                after the delay has elapsed.
+  //   co_await os::event(mask)   : Continue on the first activation
+  //                                at which one of the events in the
+  //                                mask is set. This yields the event.
+  // The coroutine frames are allocated from a static pool having
+  // OS_COROUTINE_FRAME_COUNT frames of OS_COROUTINE_FRAME_SIZE bytes.
+  // A coroutine task is entered into the task list with the init
+  // and task functions of os::coroutine_task_runner, for example:
+  //
+  //   os::coroutine_task app::benchmark::task_coroutine()
+  //   {
+  //     for(;;) { do_some_work(); co_await os::next_cycle(); }
+  //   }
+  //
+  //   os::task_control_block(os::coroutine_task_runner<app::benchmark::task_coroutine>::task_init,
+  //                          os::coroutine_task_runner<app::benchmark::task_coroutine>::task_func,
+  //                          os::timer_type::microseconds(UINT32_C(1000)),
+  //                          os::timer_type::microseconds(UINT32_C(   0)))
+
+  #if defined(__cpp_impl_coroutine)
+
+  #include <array>
+  #include <coroutine>
+  #include <cstddef>
+  #include <cstdint>
+  #include <os/os.h>
+
+  namespace os
+  {
+    class coroutine_frame_pool final
+    {
+    public:
+      static void* allocate(const std::size_t size) noexcept
+      {
+        if(size <= frame_size)
+        {
+          for(std::size_t index = 0U; index < frame_count; ++index)
+          {
+            if(my_frame_is_in_use[index] == false)
+            {
+              my_frame_is_in_use[index] = true;
+
+              return my_frames[index].data;
+            }
+          }
+        }
+
+        // The frame is too large, or the pool is exhausted.
+        return nullptr;
+      }
+
+      static void deallocate(void* p) noexcept
+      {
+        const std::size_t index =
+          static_cast<std::size_t>(static_cast<frame_type*>(p) - my_frames.data());
+
+        my_frame_is_in_use[index] = false;
+      }
+
+    private:
+      static constexpr std::size_t frame_size  = std::size_t(OS_COROUTINE_FRAME_SIZE);
+      static constexpr std::size_t frame_count = std::size_t(OS_COROUTINE_FRAME_COUNT);
+
+      struct alignas(alignof(std::max_align_t)) frame_type
+      {
+        std::uint8_t data[frame_size];
+      };
+
+      static inline std::array<frame_type, frame_count> my_frames;
+      static inline std::array<bool,       frame_count> my_frame_is_in_use;
+
+      coroutine_frame_pool() = delete;
+    };
+
+    class coroutine_task final
+    {
+    public:
+      struct promise_type
+      {
+        typedef enum enum_wait_type
+        {
+          wait_none,
+          wait_delay,
+          wait_event
+        }
+        wait_type;
+
+        wait_type  my_wait       = wait_none;
+        timer_type my_timer      { };
+        event_type my_event_mask = event_type(0U);
+
+        static void* operator new(const std::size_t size) noexcept { return coroutine_frame_pool::allocate(size); }
+
+        static void operator delete(void* p) noexcept { coroutine_frame_pool::deallocate(p); }
+
+        static coroutine_task get_return_object_on_allocation_failure() noexcept { return coroutine_task(); }
+
+        coroutine_task get_return_object() noexcept
+        {
+          return coroutine_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Begin with the first activation of the task, and remain
+        // suspended at the end, so that the owner destroys the frame.
+        std::suspend_always initial_suspend() const noexcept { return { }; }
+        std::suspend_always final_suspend  () const noexcept { return { }; }
+
+        void return_void() const noexcept { }
+
+        void unhandled_exception() const noexcept { }
+
+        bool is_ready() const
+        {
+          bool coroutine_is_ready = true;
+
+          if(my_wait == wait_delay)
+          {
+            coroutine_is_ready = my_timer.timeout();
+          }
+          else if(my_wait == wait_event)
+          {
+            event_type the_event;
+
+            get_event(the_event);
+
+            coroutine_is_ready = ((the_event & my_event_mask) != event_type(0U));
+          }
+
+          return coroutine_is_ready;
+        }
+      };
+
+      typedef std::coroutine_handle<promise_type> handle_type;
+
+      coroutine_task() noexcept : my_handle() { }
+
+      coroutine_task(coroutine_task&& other_task) noexcept : my_handle(other_task.my_handle)
+      {
+        other_task.my_handle = handle_type();
+      }
+
+      ~coroutine_task()
+      {
+        if(my_handle)
+        {
+          my_handle.destroy();
+        }
+      }
+
+      coroutine_task& operator=(coroutine_task&& other_task) noexcept
+      {
+        if(this != &other_task)
+        {
+          if(my_handle)
+          {
+            my_handle.destroy();
+          }
+
+          my_handle = other_task.my_handle;
+
+          other_task.my_handle = handle_type();
+        }
+
+        return *this;
+      }
+
+      bool valid() const noexcept { return static_cast<bool>(my_handle); }
+
+      bool done() const noexcept { return ((valid() == false) || my_handle.done()); }
+
+      void resume()
+      {
+        // Resume the coroutine up to its next suspension point
+        // if the condition that it is waiting for is fulfilled.
+        if((done() == false) && my_handle.promise().is_ready())
+        {
+          my_handle.resume();
+        }
+      }
+
+    private:
+      handle_type my_handle;
+
+      explicit coroutine_task(const handle_type handle) noexcept : my_handle(handle) { }
+
+      coroutine_task(const coroutine_task&) = delete;
+      coroutine_task& operator=(const coroutine_task&) = delete;
+    };
+
+    struct next_cycle_awaiter
+    {
+      bool await_ready() const noexcept { return false; }
+
+      void await_suspend(const coroutine_task::handle_type handle) const noexcept
+      {
+        handle.promise().my_wait = coroutine_task::promise_type::wait_none;
+      }
+
+      void await_resume() const noexcept { }
+    };
+
+    struct delay_awaiter
+    {
+      const tick_type my_delay;
+
+      bool await_ready() const noexcept { return (my_delay == tick_type(0U)); }
+
+      void await_suspend(const coroutine_task::handle_type handle) const
+      {
+        handle.promise().my_wait = coroutine_task::promise_type::wait_delay;
+
+        handle.promise().my_timer.start_relative(my_delay);
+      }
+
+      void await_resume() const noexcept { }
+    };
+
+    struct event_awaiter
+    {
+      const event_type my_event_mask;
+
+      bool await_ready() const
+      {
+        // Do not suspend if one of the events is already set.
+        return ((await_resume() & my_event_mask) != event_type(0U));
+      }
+
+      void await_suspend(const coroutine_task::handle_type handle) const noexcept
+      {
+        handle.promise().my_wait       = coroutine_task::promise_type::wait_event;
+        handle.promise().my_event_mask = my_event_mask;
+      }
+
+      event_type await_resume() const
+      {
+        event_type the_event;
+
+        get_event(the_event);
+
+        return the_event;
+      }
+    };
+
+    inline next_cycle_awaiter next_cycle()                              { return next_cycle_awaiter { }; }
+    inline delay_awaiter      delay     (const tick_type& delay_ticks)  { return delay_awaiter { delay_ticks }; }
+    inline event_awaiter      event     (const event_type& event_mask)  { return event_awaiter { event_mask }; }
+
+    // Provide the init and task functions of a coroutine task.
+    // The coroutine is created in the task initialization,
+    // and it is resumed on each activation of the task.
+    template<coroutine_task(*coroutine_function)()>
+    struct coroutine_task_runner
+    {
+      static inline coroutine_task my_task;
+
+      static void task_init() { my_task = coroutine_function(); }
+      static void task_func() { my_task.resume(); }
+    };
+  }
+
+  #endif // __cpp_impl_coroutine
+
+#endif // OS_COROUTINE_2020_10_17_H_
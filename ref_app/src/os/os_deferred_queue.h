@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef OS_DEFERRED_QUEUE_2020_10_17_H_
+  #define OS_DEFERRED_QUEUE_2020_10_17_H_
+
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <mcal_irq.h>
+  #include <os/os_cfg.h>
+
+  namespace os
+  {
+    // The function of a deferred work item, which is called
+    // by the scheduler with the payload of the item.
+    typedef void(*deferred_function_type)(const std::uintptr_t payload);
+
+    // The fixed-capacity queue of the work that interrupt service
+    // routines defer to the scheduler. Any number of producers push
+    // work items, and the scheduler (the one and only consumer) pops
+    // and calls them. A push costs two atomic additions and never
+    // waits for other producers (or for the consumer), so it is
+    // wait-free. When the queue is full, the push fails. An item
+    // whose producer has been interrupted between claiming it and
+    // publishing it holds back the items behind it until it is
+    // published. Without lock-free atomics (see OS_EVENT_ACCESS_TYPE),
+    // the push and the pop are short critical sections instead.
+    template<const std::size_t capacity>
+    class deferred_queue final
+    {
+    public:
+      static_assert((capacity != 0U) && ((capacity & (capacity - 1U)) == 0U),
+                    "the capacity of the deferred queue must be a power of two");
+
+      deferred_queue() : my_items(),
+                         my_count(0U),
+                         my_tail (0U),
+                         my_head (0U) { }
+
+      bool push(const deferred_function_type function, const std::uintptr_t payload)
+      {
+        #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+
+        // Reserve a place in the queue. Since the reserved places
+        // never exceed the capacity, the claimed item is free.
+        if(__atomic_fetch_add(&my_count, std::uint32_t(1U), __ATOMIC_ACQUIRE) >= std::uint32_t(capacity))
+        {
+          static_cast<void>(__atomic_fetch_sub(&my_count, std::uint32_t(1U), __ATOMIC_RELAXED));
+
+          return false;
+        }
+
+        const std::uint32_t sequence = __atomic_fetch_add(&my_tail, std::uint32_t(1U), __ATOMIC_RELAXED);
+
+        item_type& the_item = my_items[sequence & item_mask];
+
+        the_item.function = function;
+        the_item.payload  = payload;
+
+        // Publish the item by writing its sequence number last.
+        __atomic_store_n(&the_item.sequence, std::uint32_t(sequence + 1U), __ATOMIC_RELEASE);
+
+        return true;
+
+        #else
+
+        mcal::irq::disable_all();
+
+        const bool queue_is_full = (my_count >= std::uint32_t(capacity));
+
+        if(queue_is_full == false)
+        {
+          item_type& the_item = my_items[my_tail & item_mask];
+
+          the_item.function = function;
+          the_item.payload  = payload;
+          the_item.sequence = std::uint32_t(my_tail + 1U);
+
+          ++my_tail;
+          ++my_count;
+        }
+
+        mcal::irq::enable_all();
+
+        return (queue_is_full == false);
+
+        #endif
+      }
+
+      bool is_empty() const
+      {
+        #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+        return (__atomic_load_n(&my_count, __ATOMIC_RELAXED) == std::uint32_t(0U));
+        #else
+        return (*static_cast<const volatile std::uint32_t*>(&my_count) == std::uint32_t(0U));
+        #endif
+      }
+
+      void drain()
+      {
+        // Call the published items in the order of their claims.
+        // At most one queue's capacity of items is called per drain,
+        // so that a storm of interrupts can not starve the tasks.
+        deferred_function_type function;
+        std::uintptr_t         payload;
+
+        for(std::size_t count = 0U; ((count < capacity) && pop(function, payload)); ++count)
+        {
+          function(payload);
+        }
+      }
+
+    private:
+      struct item_type
+      {
+        deferred_function_type function;
+        std::uintptr_t         payload;
+        std::uint32_t          sequence;
+      };
+
+      static constexpr std::uint32_t item_mask = std::uint32_t(capacity - 1U);
+
+      std::array<item_type, capacity> my_items;
+      std::uint32_t                   my_count;
+      std::uint32_t                   my_tail;
+      std::uint32_t                   my_head;
+
+      bool pop(deferred_function_type& function, std::uintptr_t& payload)
+      {
+        item_type& the_item = my_items[my_head & item_mask];
+
+        #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+
+        if(__atomic_load_n(&the_item.sequence, __ATOMIC_ACQUIRE) != std::uint32_t(my_head + 1U))
+        {
+          return false;
+        }
+
+        function = the_item.function;
+        payload  = the_item.payload;
+
+        ++my_head;
+
+        // Release the place of the item before it is called,
+        // so that the item itself can defer further work.
+        static_cast<void>(__atomic_fetch_sub(&my_count, std::uint32_t(1U), __ATOMIC_RELEASE));
+
+        return true;
+
+        #else
+
+        mcal::irq::disable_all();
+
+        const bool item_is_published = (the_item.sequence == std::uint32_t(my_head + 1U));
+
+        if(item_is_published)
+        {
+          function = the_item.function;
+          payload  = the_item.payload;
+
+          ++my_head;
+          --my_count;
+        }
+
+        mcal::irq::enable_all();
+
+        return item_is_published;
+
+        #endif
+      }
+    };
+  }
+
+#endif // OS_DEFERRED_QUEUE_2020_10_17_H_
@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef OS_READY_QUEUE_2020_10_17_H_
+  #define OS_READY_QUEUE_2020_10_17_H_
+
+  #include <algorithm>
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <limits>
+  #include <os/os_task_control_block.h>
+
+  namespace os
+  {
+    // The ready queue of the scheduler consists of two binary min-heaps
+    // holding task indices. The timer heap is ordered by the timeout
+    // point of each task's timer, so the next task to become due
+    // is always on top. The ready heap is ordered by task index,
+    // which is the task priority, so the highest-priority ready task
+    // is always on top. Pushing and popping costs O(log n), and
+    // checking if anything is due costs one comparison.
+
+    template<const std::size_t task_count>
+    class ready_queue final
+    {
+    public:
+      typedef std::uint_fast16_t index_type;
+
+      static_assert(task_count <= std::size_t(UINT16_C(0xFFFF)),
+                    "the task count of the ready queue exceeds the index range");
+
+      typedef enum enum_ready_reason_type
+      {
+        ready_reason_none  = 0U,
+        ready_reason_event = 1U,
+        ready_reason_timer = 2U
+      }
+      ready_reason_type;
+
+      explicit ready_queue(task_control_block* first_tcb) : my_first_tcb  (first_tcb),
+                                                            my_timer_heap (),
+                                                            my_ready_heap (),
+                                                            my_reasons    (),
+                                                            my_timer_count(0U),
+                                                            my_ready_count(0U) { }
+
+      ~ready_queue() { }
+
+      void push_timer(const index_type index)
+      {
+        my_timer_heap[my_timer_count] = index;
+
+        sift_up(my_timer_heap, my_timer_count, &ready_queue::timer_is_before);
+
+        ++my_timer_count;
+      }
+
+      bool timer_is_due(const tick_type& timepoint) const
+      {
+        return (   (my_timer_count != 0U)
+                &&  my_first_tcb[my_timer_heap[0U]].my_timer.timeout_of_specific_timepoint(timepoint));
+      }
+
+      tick_type get_ticks_until_due(const tick_type& timepoint) const
+      {
+        return ((my_timer_count != 0U)
+                 ? my_first_tcb[my_timer_heap[0U]].my_timer.get_ticks_until_timeout(timepoint)
+                 : (std::numeric_limits<tick_type>::max)());
+      }
+
+      index_type pop_timer()
+      {
+        return pop(my_timer_heap, my_timer_count, &ready_queue::timer_is_before);
+      }
+
+      void push_ready(const index_type index, const ready_reason_type reason)
+      {
+        // A task is held (at most) once in the ready heap.
+        // Additional reasons for readiness are accumulated.
+        if(my_reasons[index] == std::uint_fast8_t(ready_reason_none))
+        {
+          my_ready_heap[my_ready_count] = index;
+
+          sift_up(my_ready_heap, my_ready_count, &ready_queue::ready_is_before);
+
+          ++my_ready_count;
+        }
+
+        my_reasons[index] |= std::uint_fast8_t(reason);
+      }
+
+      bool ready_is_empty() const { return (my_ready_count == 0U); }
+
+      index_type pop_ready(std::uint_fast8_t& reasons)
+      {
+        const index_type index = pop(my_ready_heap, my_ready_count, &ready_queue::ready_is_before);
+
+        reasons = my_reasons[index];
+
+        my_reasons[index] = std::uint_fast8_t(ready_reason_none);
+
+        return index;
+      }
+
+    private:
+      typedef std::array<index_type, task_count> heap_type;
+
+      typedef bool(ready_queue::*compare_function_type)(const index_type, const index_type) const;
+
+      task_control_block* const                     my_first_tcb;
+      heap_type                                     my_timer_heap;
+      heap_type                                     my_ready_heap;
+      std::array<std::uint_fast8_t, task_count>     my_reasons;
+      index_type                                    my_timer_count;
+      index_type                                    my_ready_count;
+
+      bool timer_is_before(const index_type a, const index_type b) const
+      {
+        return my_first_tcb[a].my_timer.timeout_is_before(my_first_tcb[b].my_timer);
+      }
+
+      bool ready_is_before(const index_type a, const index_type b) const
+      {
+        return (a < b);
+      }
+
+      void sift_up(heap_type& heap, index_type child, const compare_function_type is_before) const
+      {
+        while(child != 0U)
+        {
+          const index_type parent = static_cast<index_type>((child - 1U) / 2U);
+
+          if((this->*is_before)(heap[child], heap[parent]) == false)
+          {
+            break;
+          }
+
+          std::swap(heap[child], heap[parent]);
+
+          child = parent;
+        }
+      }
+
+      index_type pop(heap_type& heap, index_type& count, const compare_function_type is_before) const
+      {
+        const index_type top = heap[0U];
+
+        --count;
+
+        heap[0U] = heap[count];
+
+        // Sift the former last element down to restore the heap property.
+        index_type parent = 0U;
+
+        for(;;)
+        {
+          const index_type left  = static_cast<index_type>((parent * 2U) + 1U);
+          const index_type right = static_cast<index_type>(left + 1U);
+
+          index_type smallest = parent;
+
+          if((left < count) && (this->*is_before)(heap[left], heap[smallest]))
+          {
+            smallest = left;
+          }
+
+          if((right < count) && (this->*is_before)(heap[right], heap[smallest]))
+          {
+            smallest = right;
+          }
+
+          if(smallest == parent)
+          {
+            break;
+          }
+
+          std::swap(heap[parent], heap[smallest]);
+
+          parent = smallest;
+        }
+
+        return top;
+      }
+
+      ready_queue();
+      ready_queue(const ready_queue&);
+      ready_queue& operator=(const ready_queue&);
+    };
+  }
+
+#endif // OS_READY_QUEUE_2020_10_17_H_
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2016.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -9,13 +9,20 @@
 
 bool os::task_control_block::execute(const os::tick_type& timepoint_of_ckeck_ready)
 {
+  // Event-triggered tasks are dispatched ahead of the cyclic tasks
+  // in execute_event_triggered() and are skipped here.
+  if(my_activation == task_activation_event)
+  {
+    return false;
+  }
+
   // Check for a task event.
-  const bool task_does_have_event = (my_event != event_type(0U));
+  const bool task_does_have_event = (get_event_relaxed() != event_type(0U));
 
   if(task_does_have_event)
   {
     // Call the task function because of an event.
-    my_func();
+    call_func();
   }
 
   // Check for a task timeout.
@@ -25,12 +32,49 @@ bool os::task_control_block::execute(const os::tick_type& timepoint_of_ckeck_rea
   if(task_does_have_timeout)
   {
     // Increment the task's interval timer with the task cycle.
-    my_timer.start_interval(my_cycle);
+    start_next_interval(timepoint_of_ckeck_ready);
 
     // Call the task function because of a timer timeout.
-    my_func();
+    call_func();
   }
 
   return (task_does_have_event || task_does_have_timeout);
 }
 
+
+bool os::task_control_block::execute_event_triggered(const os::tick_type& timepoint_of_ckeck_ready)
+{
+  // Check for an activating event or a timeout.
+  const bool task_does_have_event = event_is_activating();
+
+  const bool task_does_have_timeout = (   timer_is_armed()
+                                       && my_timer.timeout_of_specific_timepoint(timepoint_of_ckeck_ready));
+
+  const bool task_is_ready = (task_does_have_event || task_does_have_timeout);
+
+  if(task_is_ready)
+  {
+    if(my_wait_is_pending)
+    {
+      // This activation (be it from an event or from the timeout)
+      // completes the wait. Resume the cyclic activation (if any)
+      // relative to now.
+      my_wait_mask             = (std::numeric_limits<event_type>::max)();
+      my_wait_is_pending       = false;
+      my_wait_timeout_is_armed = false;
+
+      my_timer.start_relative(my_cycle);
+    }
+    else if(task_does_have_timeout)
+    {
+      // Increment the task's interval timer with the task cycle.
+      start_next_interval(timepoint_of_ckeck_ready);
+    }
+
+    // Call the task function once, be it because of an event
+    // or because of a timer timeout.
+    call_func();
+  }
+
+  return task_is_ready;
+}
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2007 - 2016.
+//  Copyright Christopher Kormanyos 2007 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -12,40 +12,170 @@
   #include <cstdint>
   #include <limits>
   #include <os/os.h>
+  #include <os/os_trace.h>
 
   namespace os
   {
+    template<const std::size_t task_count>
+    class ready_queue;
+
     class task_control_block final
     {
     public:
       task_control_block(const function_type init,
                          const function_type func,
                          const tick_type cycle,
-                         const tick_type offset) : my_init (init),
-                                                   my_func (func),
-                                                   my_cycle(cycle),
-                                                   my_timer(offset),
-                                                   my_event() { }
-
-      task_control_block(const task_control_block& other_tcb) : my_init (other_tcb.my_init),
-                                                                my_func (other_tcb.my_func),
-                                                                my_cycle(other_tcb.my_cycle),
-                                                                my_timer(other_tcb.my_timer),
-                                                                my_event(other_tcb.my_event) { }
+                         const tick_type offset,
+                         const task_activation_type activation = task_activation_cyclic)
+        : my_init                 (init),
+          my_func                 (func),
+          my_cycle                (cycle),
+          my_activation           (activation),
+          my_timer                (offset),
+          my_event                (),
+          my_wait_mask            ((std::numeric_limits<event_type>::max)()),
+          my_wait_is_pending      (false),
+          my_wait_timeout_is_armed(false)
+          #if (OS_TASK_PROFILING == 1)
+          , my_statistics         ()
+          , my_deadline_is_pending(false)
+          #endif
+          { }
+
+      task_control_block(const task_control_block& other_tcb)
+        : my_init                 (other_tcb.my_init),
+          my_func                 (other_tcb.my_func),
+          my_cycle                (other_tcb.my_cycle),
+          my_activation           (other_tcb.my_activation),
+          my_timer                (other_tcb.my_timer),
+          my_event                (other_tcb.my_event),
+          my_wait_mask            (other_tcb.my_wait_mask),
+          my_wait_is_pending      (other_tcb.my_wait_is_pending),
+          my_wait_timeout_is_armed(other_tcb.my_wait_timeout_is_armed)
+          #if (OS_TASK_PROFILING == 1)
+          , my_statistics         (other_tcb.my_statistics)
+          , my_deadline_is_pending(other_tcb.my_deadline_is_pending)
+          #endif
+          { }
 
       ~task_control_block() { }
 
     private:
-      const function_type my_init;
-      const function_type my_func;
-      const tick_type     my_cycle;
-            timer_type    my_timer;
-            event_type    my_event;
+      const function_type        my_init;
+      const function_type        my_func;
+      const tick_type            my_cycle;
+      const task_activation_type my_activation;
+            timer_type           my_timer;
+            event_type           my_event;
+            event_type           my_wait_mask;
+            bool                 my_wait_is_pending;
+            bool                 my_wait_timeout_is_armed;
+
+      #if (OS_TASK_PROFILING == 1)
+      task_statistics my_statistics;
+      bool            my_deadline_is_pending;
+      #endif
 
       void initialize() const { my_init(); }
 
+      void call_func()
+      {
+        #if (OS_TRACE == 1)
+        trace::record_running_task(trace::record_task_begin);
+        #endif
+
+        #if (OS_TASK_PROFILING == 1)
+        const tick_type timepoint_of_start = timer_type::get_mark();
+
+        my_func();
+
+        const tick_type timepoint_of_end = timer_type::get_mark();
+
+        my_statistics.record_run(timepoint_of_end - timepoint_of_start, my_cycle);
+
+        if(my_deadline_is_pending)
+        {
+          // After a timer activation, the timer holds the deadline.
+          my_deadline_is_pending = false;
+
+          my_statistics.record_deadline(my_timer.timeout_of_specific_timepoint(timepoint_of_end));
+        }
+        #else
+        my_func();
+        #endif
+
+        #if (OS_TRACE == 1)
+        trace::record_running_task(trace::record_task_end);
+        #endif
+      }
+
+      void start_next_interval(const tick_type& timepoint_of_ckeck_ready)
+      {
+        #if (OS_TASK_PROFILING == 1)
+        my_statistics.record_activation(my_timer.get_ticks_since_timeout(timepoint_of_ckeck_ready));
+        #else
+        static_cast<void>(timepoint_of_ckeck_ready);
+        #endif
+
+        // Increment the task's interval timer with the task cycle.
+        my_timer.start_interval(my_cycle);
+
+        #if (OS_TASK_PROFILING == 1)
+        my_deadline_is_pending = true;
+        #endif
+      }
+
+      tick_type get_deadline_key(const tick_type& timepoint_of_ckeck_ready) const
+      {
+        // The deadline of a ready cyclic task (the timeout plus the cycle)
+        // relative to the timepoint and shifted by half of the tick range,
+        // so that it is ordered correctly even if it has already passed.
+        // A task without a cycle (activated by its events) is due now.
+        const tick_type deadline_from_timepoint =
+          ((my_cycle != tick_type(0U)) ? tick_type(my_cycle - my_timer.get_ticks_since_timeout(timepoint_of_ckeck_ready))
+                                       : tick_type(0U));
+
+        return tick_type(deadline_from_timepoint + tick_type((std::numeric_limits<tick_type>::max)() / 2U));
+      }
+
+      event_type get_event_relaxed() const
+      {
+        // Read the task event in the scheduler. An event that is set
+        // concurrently is caught on the next scheduler pass at the latest.
+        #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+        return __atomic_load_n(&my_event, __ATOMIC_RELAXED);
+        #else
+        return my_event;
+        #endif
+      }
+
+      bool event_is_activating() const
+      {
+        // Only the events in the wait mask activate the task.
+        // The wait mask has all bits set, unless the task is
+        // an event-triggered task waiting via os::wait_event.
+        return ((get_event_relaxed() & my_wait_mask) != event_type(0U));
+      }
+
+      bool timer_is_armed() const
+      {
+        // While waiting for an event, the timer holds the timeout
+        // of the wait (if any). Otherwise it holds the task cycle.
+        return (my_wait_is_pending ? my_wait_timeout_is_armed
+                                   : (my_cycle != tick_type(0U)));
+      }
+
+      tick_type get_ticks_until_ready(const tick_type& timepoint_of_ckeck_ready) const
+      {
+        return (event_is_activating() ? tick_type(0U)
+                                      : (timer_is_armed() ? my_timer.get_ticks_until_timeout(timepoint_of_ckeck_ready)
+                                                          : (std::numeric_limits<tick_type>::max)()));
+      }
+
       bool execute(const tick_type& timepoint_of_ckeck_ready);
 
+      bool execute_event_triggered(const tick_type& timepoint_of_ckeck_ready);
+
       task_control_block();
       task_control_block& operator=(const task_control_block&);
 
@@ -53,6 +183,16 @@
       friend bool set_event  (const task_id_type, const event_type&);
       friend void get_event  (event_type&);
       friend void clear_event(const event_type&);
+      friend void wait_event (const event_type&, const tick_type&);
+      friend tick_type get_ticks_until_next_task();
+      friend bool spawn_task(const function_type, const function_type, const tick_type&, const tick_type&, task_id_type&);
+
+      #if (OS_TASK_PROFILING == 1)
+      friend bool get_task_statistics(const task_id_type, task_statistics&);
+      #endif
+
+      template<const std::size_t task_count>
+      friend class ready_queue;
     };
   }
 
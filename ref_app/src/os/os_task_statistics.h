@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef OS_TASK_STATISTICS_2020_10_17_H_
+  #define OS_TASK_STATISTICS_2020_10_17_H_
+
+  #include <cstdint>
+  #include <limits>
+  #include <os/os_cfg.h>
+
+  namespace os
+  {
+    // The run time and activation lateness statistics of a task,
+    // measured in timer ticks. The means are exponentially weighted
+    // over (roughly) the last 16 runs and are kept scaled by 16,
+    // so that each update costs a shift, a subtraction and an addition.
+    struct task_statistics
+    {
+      typedef std::uint_fast32_t count_type;
+
+      tick_type  run_time_min;
+      tick_type  run_time_max;
+      tick_type  run_time_mean_x16;
+      tick_type  lateness_max;
+      tick_type  lateness_mean_x16;
+      count_type run_count;
+      count_type activation_count;
+      count_type overrun_count;
+      count_type deadline_miss_count;
+
+      task_statistics() : run_time_min       ((std::numeric_limits<tick_type>::max)()),
+                          run_time_max       (0U),
+                          run_time_mean_x16  (0U),
+                          lateness_max       (0U),
+                          lateness_mean_x16  (0U),
+                          run_count          (0U),
+                          activation_count   (0U),
+                          overrun_count      (0U),
+                          deadline_miss_count(0U) { }
+
+      tick_type get_run_time_mean() const { return run_time_mean_x16 / 16U; }
+      tick_type get_lateness_mean() const { return lateness_mean_x16 / 16U; }
+
+      void record_activation(const tick_type lateness)
+      {
+        // Record the lateness of a timer activation, in other words
+        // the ticks between the task's timeout and its dispatch.
+        lateness_max = ((lateness > lateness_max) ? lateness : lateness_max);
+
+        lateness_mean_x16 = ((activation_count == 0U) ? tick_type(lateness * 16U)
+                                                      : tick_type((lateness_mean_x16 - (lateness_mean_x16 / 16U)) + lateness));
+
+        ++activation_count;
+      }
+
+      void record_run(const tick_type run_time, const tick_type cycle)
+      {
+        // Record the run time of one call of the task function.
+        // A run that takes longer than the task cycle is an overrun.
+        run_time_min = ((run_time < run_time_min) ? run_time : run_time_min);
+        run_time_max = ((run_time > run_time_max) ? run_time : run_time_max);
+
+        run_time_mean_x16 = ((run_count == 0U) ? tick_type(run_time * 16U)
+                                               : tick_type((run_time_mean_x16 - (run_time_mean_x16 / 16U)) + run_time));
+
+        if((cycle != tick_type(0U)) && (run_time > cycle))
+        {
+          ++overrun_count;
+        }
+
+        ++run_count;
+      }
+
+      void record_deadline(const bool deadline_is_missed)
+      {
+        // The deadline of a timer activation is the next activation
+        // (the release plus the cycle). It is missed if the task
+        // function returns after it.
+        if(deadline_is_missed)
+        {
+          ++deadline_miss_count;
+        }
+      }
+    };
+  }
+
+#endif // OS_TASK_STATISTICS_2020_10_17_H_
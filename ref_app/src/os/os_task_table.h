@@ -0,0 +1,302 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef OS_TASK_TABLE_2020_10_17_H_
+  #define OS_TASK_TABLE_2020_10_17_H_
+
+  #include <cstddef>
+  #include <cstdint>
+
+  namespace os
+  {
+    // The timing of one task in timer ticks: the task cycle and the
+    // declared worst-case execution budget. A cycle of zero denotes
+    // a task that is activated by events only.
+    template<const std::uintmax_t cycle,
+             const std::uintmax_t budget>
+    struct task_timing
+    {
+      static constexpr std::uintmax_t my_cycle  = cycle;
+      static constexpr std::uintmax_t my_budget = budget;
+    };
+
+    // The compile-time task table holds the timings of all tasks in
+    // the order of the task list. It computes the task offsets, the
+    // hyperperiod and the peak load. The offsets are chosen such that
+    // the cyclic tasks have pairwise distinct release times modulo the
+    // greatest common divisor of the cycles, spread evenly across it.
+    // Since all releases of a task share this residue, no two cyclic
+    // tasks are ever activated at the same tick. This requires that the
+    // divisor has at least as many ticks as there are cyclic tasks,
+    // which is checked at compile time.
+    // Everything is written in C++11 constexpr, and the recursions
+    // over the releases are split in halves to limit their depth.
+
+    namespace detail
+    {
+      // The timings of the task table and the (recursive) helpers
+      // for the quantities that are computed once for the whole table.
+      template<typename... timings>
+      class task_table_base
+      {
+      protected:
+        static constexpr std::size_t my_size = sizeof...(timings);
+
+        static constexpr std::uintmax_t my_cycles [my_size] = { timings::my_cycle ... };
+        static constexpr std::uintmax_t my_budgets[my_size] = { timings::my_budget ... };
+
+        static constexpr std::uintmax_t gcd(const std::uintmax_t a, const std::uintmax_t b)
+        {
+          return ((b == 0U) ? a : gcd(b, a % b));
+        }
+
+        static constexpr std::uintmax_t lcm(const std::uintmax_t a, const std::uintmax_t b)
+        {
+          return (((a == 0U) || (b == 0U)) ? (a + b) : ((a / gcd(a, b)) * b));
+        }
+
+        static constexpr std::uintmax_t max(const std::uintmax_t a, const std::uintmax_t b)
+        {
+          return ((a > b) ? a : b);
+        }
+
+        static constexpr std::uintmax_t gcd_from(const std::size_t index)
+        {
+          return ((index == my_size) ? 0U : gcd(my_cycles[index], gcd_from(index + 1U)));
+        }
+
+        static constexpr std::uintmax_t lcm_from(const std::size_t index)
+        {
+          return ((index == my_size) ? 0U : lcm(my_cycles[index], lcm_from(index + 1U)));
+        }
+
+        static constexpr std::size_t cyclic_count_before(const std::size_t index)
+        {
+          return ((index == 0U) ? 0U : (cyclic_count_before(index - 1U) + ((my_cycles[index - 1U] != 0U) ? 1U : 0U)));
+        }
+      };
+
+      // A list of indices and its generator (std::index_sequence is C++14).
+      template<std::size_t... indices>
+      struct index_list { };
+
+      template<std::size_t count, std::size_t... indices>
+      struct make_index_list : make_index_list<count - 1U, count - 1U, indices...> { };
+
+      template<std::size_t... indices>
+      struct make_index_list<0U, indices...>
+      {
+        typedef index_list<indices...> type;
+      };
+
+      template<typename... timings>
+      constexpr std::uintmax_t task_table_base<timings...>::my_cycles[task_table_base<timings...>::my_size];
+
+      template<typename... timings>
+      constexpr std::uintmax_t task_table_base<timings...>::my_budgets[task_table_base<timings...>::my_size];
+    }
+
+    template<typename... timings>
+    class task_table final : private detail::task_table_base<timings...>
+    {
+    private:
+      typedef detail::task_table_base<timings...> base_class_type;
+
+      using base_class_type::my_size;
+      using base_class_type::my_cycles;
+      using base_class_type::my_budgets;
+      using base_class_type::max;
+
+      static constexpr std::uintmax_t my_cycle_divisor = base_class_type::gcd_from(0U);
+      static constexpr std::uintmax_t my_hyperperiod   = base_class_type::lcm_from(0U);
+      static constexpr std::size_t    my_cyclic_count  = base_class_type::cyclic_count_before(my_size);
+
+      static_assert(my_cycle_divisor >= std::uintmax_t(my_cyclic_count),
+                    "the greatest common divisor of the cycles must have at least as many ticks as there are cyclic tasks");
+
+      static constexpr bool is_released_at(const std::size_t index, const std::uintmax_t timepoint)
+      {
+        // Within the steady state, the offset is less than the cycle.
+        return (   (my_cycles[index] != 0U)
+                && ((((timepoint + my_cycles[index]) - offset(index)) % my_cycles[index]) == 0U));
+      }
+
+      static constexpr std::uintmax_t budget_released_at(const std::uintmax_t timepoint, const std::size_t index)
+      {
+        return ((index == my_size) ? 0U
+                                   : (  (is_released_at(index, timepoint) ? my_budgets[index] : 0U)
+                                      + budget_released_at(timepoint, index + 1U)));
+      }
+
+      static constexpr std::uintmax_t peak_load_of_releases(const std::size_t index,
+                                                            const std::uintmax_t first_release,
+                                                            const std::uintmax_t release_count)
+      {
+        return ((release_count == 1U)
+                 ? budget_released_at(offset(index) + (first_release * my_cycles[index]), 0U)
+                 : max(peak_load_of_releases(index, first_release, release_count / 2U),
+                       peak_load_of_releases(index, first_release + (release_count / 2U), release_count - (release_count / 2U))));
+      }
+
+      static constexpr std::uintmax_t peak_load_from(const std::size_t index)
+      {
+        return ((index == my_size) ? 0U
+                                   : max(((my_cycles[index] == 0U) ? 0U
+                                                                   : peak_load_of_releases(index, 0U, my_hyperperiod / my_cycles[index])),
+                                         peak_load_from(index + 1U)));
+      }
+
+      static constexpr std::uintmax_t utilization_permille_from(const std::size_t index)
+      {
+        return ((index == my_size) ? 0U
+                                   : (  ((my_cycles[index] == 0U) ? 0U : ((my_budgets[index] * 1000U) / my_cycles[index]))
+                                      + utilization_permille_from(index + 1U)));
+      }
+
+      static constexpr bool budgets_are_within_cycles_from(const std::size_t index)
+      {
+        return ((index == my_size) || (   ((my_cycles[index] == 0U) || (my_budgets[index] <= my_cycles[index]))
+                                       && budgets_are_within_cycles_from(index + 1U)));
+      }
+
+      static constexpr std::size_t frame_task_count_from(const std::size_t frame, const std::size_t index)
+      {
+        return ((index == my_size) ? 0U
+                                   : (  (is_released_in_frame(index, frame) ? 1U : 0U)
+                                      + frame_task_count_from(frame, index + 1U)));
+      }
+
+      static constexpr std::uintmax_t frame_budget_from(const std::size_t frame, const std::size_t index)
+      {
+        return ((index == my_size) ? 0U
+                                   : (  (is_released_in_frame(index, frame) ? my_budgets[index] : 0U)
+                                      + frame_budget_from(frame, index + 1U)));
+      }
+
+      static constexpr std::uintmax_t frame_budget_max_from(const std::size_t frame)
+      {
+        return ((frame == frame_count()) ? 0U : max(frame_budget_from(frame, 0U), frame_budget_max_from(frame + 1U)));
+      }
+
+      static constexpr std::size_t frame_of_entry(const std::size_t entry, const std::size_t frame)
+      {
+        return ((frame_begin(frame + 1U) > entry) ? frame : frame_of_entry(entry, frame + 1U));
+      }
+
+      static constexpr std::size_t released_task_in_frame(const std::size_t frame, const std::size_t position, const std::size_t index)
+      {
+        return (is_released_in_frame(index, frame) ? ((position == 0U) ? index : released_task_in_frame(frame, position - 1U, index + 1U))
+                                                   : released_task_in_frame(frame, position, index + 1U));
+      }
+
+    public:
+      static constexpr std::size_t size() { return my_size; }
+
+      static constexpr std::uintmax_t cycle (const std::size_t index) { return my_cycles [index]; }
+      static constexpr std::uintmax_t budget(const std::size_t index) { return my_budgets[index]; }
+
+      // The greatest common divisor of the cycles of the cyclic tasks.
+      static constexpr std::uintmax_t cycle_divisor() { return my_cycle_divisor; }
+
+      // The least common multiple of the cycles of the cyclic tasks.
+      static constexpr std::uintmax_t hyperperiod() { return my_hyperperiod; }
+
+      // The number of cyclic tasks.
+      static constexpr std::size_t cyclic_count() { return my_cyclic_count; }
+
+      // The offset of the first activation of a cyclic task.
+      static constexpr std::uintmax_t offset(const std::size_t index)
+      {
+        return ((my_cycles[index] == 0U) ? 0U
+                                         : ((base_class_type::cyclic_count_before(index) * my_cycle_divisor) / my_cyclic_count));
+      }
+
+      // The peak load is the largest sum of the budgets of the tasks
+      // that are released at the same tick within the hyperperiod.
+      static constexpr std::uintmax_t peak_load() { return peak_load_from(0U); }
+
+      // The utilization of the cyclic tasks in permille (rounded down).
+      static constexpr std::uintmax_t utilization_permille() { return utilization_permille_from(0U); }
+
+      static constexpr bool budgets_are_within_cycles() { return budgets_are_within_cycles_from(0U); }
+
+      // The cyclic executive (see OS_SCHEDULER_TYPE in os_cfg.h) runs
+      // the cyclic tasks in minor frames having the length of the cycle
+      // divisor. The major frame is the hyperperiod. A task is released
+      // in every (cycle / minor frame)-th minor frame, beginning with its
+      // frame offset, and the frame offsets of the tasks are spread like
+      // the tick offsets above. Within a minor frame, the released tasks
+      // run in the order of the task list.
+      static constexpr std::uintmax_t minor_frame() { return my_cycle_divisor; }
+
+      static constexpr std::size_t frame_count()
+      {
+        return ((my_cycle_divisor == 0U) ? 0U : static_cast<std::size_t>(my_hyperperiod / my_cycle_divisor));
+      }
+
+      static constexpr std::size_t frame_offset(const std::size_t index)
+      {
+        return ((my_cycles[index] == 0U) ? 0U
+                                         : static_cast<std::size_t>(base_class_type::cyclic_count_before(index) % (my_cycles[index] / my_cycle_divisor)));
+      }
+
+      static constexpr bool is_released_in_frame(const std::size_t index, const std::size_t frame)
+      {
+        return (   (my_cycles[index] != 0U)
+                && ((frame % static_cast<std::size_t>(my_cycles[index] / my_cycle_divisor)) == frame_offset(index)));
+      }
+
+      static constexpr std::size_t frame_task_count(const std::size_t frame) { return frame_task_count_from(frame, 0U); }
+
+      // The sum of the budgets of the tasks released in a minor frame,
+      // and the largest such sum, which should not exceed the minor frame.
+      static constexpr std::uintmax_t frame_budget(const std::size_t frame) { return frame_budget_from(frame, 0U); }
+
+      static constexpr std::uintmax_t frame_budget_max() { return frame_budget_max_from(0U); }
+
+      // The schedule lists the released tasks of all minor frames one
+      // after the other. These are the position of the first task of
+      // a minor frame in this list, and the task at a list position.
+      static constexpr std::size_t frame_begin(const std::size_t frame)
+      {
+        return ((frame == 0U) ? 0U : (frame_begin(frame - 1U) + frame_task_count(frame - 1U)));
+      }
+
+      static constexpr std::size_t frame_entry_count() { return frame_begin(frame_count()); }
+
+      static constexpr std::size_t frame_entry(const std::size_t entry)
+      {
+        return released_task_in_frame(frame_of_entry(entry, 0U), entry - frame_begin(frame_of_entry(entry, 0U)), 0U);
+      }
+    };
+
+    // The schedule of the cyclic executive is generated at compile time
+    // from the task table. It holds the task indices of all minor frames
+    // in one list and the position of each minor frame in this list,
+    // so that a minor frame dispatches its tasks without any checks.
+    template<typename table_type,
+             typename entry_list_type = typename detail::make_index_list<table_type::frame_entry_count()>::type,
+             typename frame_list_type = typename detail::make_index_list<table_type::frame_count() + 1U>::type>
+    struct cyclic_schedule;
+
+    template<typename table_type,
+             std::size_t... entries,
+             std::size_t... frames>
+    struct cyclic_schedule<table_type, detail::index_list<entries...>, detail::index_list<frames...>>
+    {
+      static constexpr std::uint8_t  frame_entries[sizeof...(entries)] = { static_cast<std::uint8_t> (table_type::frame_entry(entries)) ... };
+      static constexpr std::uint16_t frame_begins [sizeof...(frames)]  = { static_cast<std::uint16_t>(table_type::frame_begin(frames)) ... };
+    };
+
+    template<typename table_type, std::size_t... entries, std::size_t... frames>
+    constexpr std::uint8_t cyclic_schedule<table_type, detail::index_list<entries...>, detail::index_list<frames...>>::frame_entries[sizeof...(entries)];
+
+    template<typename table_type, std::size_t... entries, std::size_t... frames>
+    constexpr std::uint16_t cyclic_schedule<table_type, detail::index_list<entries...>, detail::index_list<frames...>>::frame_begins[sizeof...(frames)];
+  }
+
+#endif // OS_TASK_TABLE_2020_10_17_H_
@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <os/os_trace.h>
+
+#if (OS_TRACE == 1)
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <mcal_cpu.h>
+#include <mcal_irq.h>
+
+namespace
+{
+  typedef std::array<os::trace::record_type, OS_TRACE_BUFFER_SIZE> trace_buffer_type;
+
+  constexpr std::uint32_t trace_buffer_mask = std::uint32_t(OS_TRACE_BUFFER_SIZE - 1U);
+
+  // The ring buffer of the trace records and the (free-running)
+  // sequence number of the next record to be written.
+  trace_buffer_type os_trace_buffer;
+  std::uint32_t     os_trace_head;
+
+  // The snapshot of the trace buffer that is written to the file.
+  trace_buffer_type os_trace_snapshot;
+
+  std::uint32_t trace_claim_sequence()
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    return __atomic_fetch_add(&os_trace_head, std::uint32_t(1U), __ATOMIC_RELAXED);
+    #else
+    mcal::irq::disable_all();
+
+    const std::uint32_t sequence = os_trace_head;
+
+    ++os_trace_head;
+
+    mcal::irq::enable_all();
+
+    return sequence;
+    #endif
+  }
+
+  // The fields of the records are written and read with atomic
+  // accesses, since a record can be read while it is overwritten.
+  // With critical sections (on a single core), volatile accesses
+  // suffice, and they are not reordered with respect to each other.
+  template<typename value_type>
+  value_type trace_load(const value_type& value)
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    return __atomic_load_n(&value, __ATOMIC_RELAXED);
+    #else
+    return *static_cast<const volatile value_type*>(&value);
+    #endif
+  }
+
+  template<typename value_type>
+  void trace_store(value_type& destination, const value_type value)
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    __atomic_store_n(&destination, value, __ATOMIC_RELAXED);
+    #else
+    *static_cast<volatile value_type*>(&destination) = value;
+    #endif
+  }
+
+  std::uint32_t trace_load_acquire(const std::uint32_t& value)
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+    #else
+    return *static_cast<const volatile std::uint32_t*>(&value);
+    #endif
+  }
+
+  void trace_store_release(std::uint32_t& destination, const std::uint32_t value)
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    __atomic_store_n(&destination, value, __ATOMIC_RELEASE);
+    #else
+    *static_cast<volatile std::uint32_t*>(&destination) = value;
+    #endif
+  }
+
+  void trace_fence_release()
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    #endif
+  }
+
+  void trace_fence_acquire()
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    #endif
+  }
+
+  bool trace_is_written_at_exit;
+
+  void trace_write_at_exit()
+  {
+    // Write once, at the normal exit or at the quick exit
+    // that the host performs upon SIGINT or SIGTERM.
+    if(trace_is_written_at_exit == false)
+    {
+      trace_is_written_at_exit = true;
+
+      static_cast<void>(os::trace::write_chrome_trace(OS_TRACE_FILE_NAME));
+    }
+  }
+}
+
+void os::trace::initialize()
+{
+  // The trace is not written in a signal handler. Instead, the host
+  // exits with std::quick_exit upon SIGINT or SIGTERM (see mcal_cpu).
+  static_cast<void>(std::atexit       (trace_write_at_exit));
+  static_cast<void>(std::at_quick_exit(trace_write_at_exit));
+
+  mcal::cpu::exit_on_signal();
+}
+
+void os::trace::record(const record_kind_type kind,
+                       const std::uint_fast16_t task,
+                       const std::uint_fast8_t thread,
+                       const event_type value)
+{
+  // Claim a record (overwriting the oldest one) and fill it.
+  // The record is invalidated (with the sequence number zero, which
+  // the reader never accepts) before its fields are written, and
+  // its new sequence number is written last, with release semantics.
+  const std::uint32_t sequence = trace_claim_sequence();
+
+  record_type& the_record = os_trace_buffer[sequence & trace_buffer_mask];
+
+  trace_store(the_record.sequence, std::uint32_t(0U));
+
+  trace_fence_release();
+
+  trace_store(the_record.timepoint, tick_type(timer_type::get_mark()));
+  trace_store(the_record.value,     event_type(value));
+  trace_store(the_record.task,      static_cast<std::uint16_t>(task));
+  trace_store(the_record.thread,    static_cast<std::uint8_t>(thread));
+  trace_store(the_record.kind,      static_cast<std::uint8_t>(kind));
+
+  trace_store_release(the_record.sequence, static_cast<std::uint32_t>(sequence + 1U));
+}
+
+std::size_t os::trace::get_records(record_type* records, const std::size_t record_count)
+{
+  const std::uint32_t head = trace_load_acquire(os_trace_head);
+
+  std::uint32_t available = ((head < std::uint32_t(OS_TRACE_BUFFER_SIZE)) ? head : std::uint32_t(OS_TRACE_BUFFER_SIZE));
+
+  if(std::size_t(available) > record_count)
+  {
+    available = static_cast<std::uint32_t>(record_count);
+  }
+
+  std::size_t count = 0U;
+
+  for(std::uint32_t sequence = head - available; sequence != head; ++sequence)
+  {
+    const record_type& the_record = os_trace_buffer[sequence & trace_buffer_mask];
+
+    const std::uint32_t expected_sequence = static_cast<std::uint32_t>(sequence + 1U);
+
+    // Skip records that are incomplete or that are overwritten
+    // during the copy. The sequence number is read before and
+    // after the fields, like in a sequence lock.
+    if(   (expected_sequence != 0U)
+       && (trace_load_acquire(the_record.sequence) == expected_sequence))
+    {
+      record_type the_copy;
+
+      the_copy.timepoint = trace_load(the_record.timepoint);
+      the_copy.value     = trace_load(the_record.value);
+      the_copy.sequence  = expected_sequence;
+      the_copy.task      = trace_load(the_record.task);
+      the_copy.thread    = trace_load(the_record.thread);
+      the_copy.kind      = trace_load(the_record.kind);
+
+      trace_fence_acquire();
+
+      if(trace_load(the_record.sequence) == expected_sequence)
+      {
+        records[count] = the_copy;
+
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+bool os::trace::write_chrome_trace(const char* file_name)
+{
+  std::FILE* trace_file = std::fopen(file_name, "w");
+
+  if(trace_file == nullptr)
+  {
+    return false;
+  }
+
+  const std::size_t count = get_records(os_trace_snapshot.data(), os_trace_snapshot.size());
+
+  static_cast<void>(std::fputs("{\"traceEvents\":[\n", trace_file));
+
+  // Unwrap the timer ticks into microseconds relative to the oldest record.
+  unsigned long long timestamp = 0U;
+
+  for(std::size_t index = 0U; index < count; ++index)
+  {
+    const record_type& the_record = os_trace_snapshot[index];
+
+    if(index != 0U)
+    {
+      // Records of different threads can be slightly out of order,
+      // so a delta in the upper half of the tick range is negative.
+      const tick_type delta = static_cast<tick_type>(the_record.timepoint - os_trace_snapshot[index - 1U].timepoint);
+
+      if(delta <= ((std::numeric_limits<tick_type>::max)() / 2U))
+      {
+        timestamp += static_cast<unsigned long long>(delta / timer_type::microseconds(1U));
+      }
+      else
+      {
+        const unsigned long long backward =
+          static_cast<unsigned long long>(static_cast<tick_type>(tick_type(0U) - delta) / timer_type::microseconds(1U));
+
+        timestamp = ((backward < timestamp) ? (timestamp - backward) : 0U);
+      }
+    }
+
+    const char* separator = ((index + 1U < count) ? "," : "");
+
+    const unsigned task   = static_cast<unsigned>(the_record.task);
+    const unsigned thread = static_cast<unsigned>(the_record.thread);
+
+    switch(the_record.kind)
+    {
+      case record_task_begin:
+      case record_task_end:
+        static_cast<void>(std::fprintf(trace_file,
+                                       "{\"name\":\"task %u\",\"cat\":\"task\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%u}%s\n",
+                                       task,
+                                       ((the_record.kind == record_task_begin) ? 'B' : 'E'),
+                                       timestamp,
+                                       thread,
+                                       separator));
+        break;
+
+      case record_idle_begin:
+      case record_idle_end:
+        static_cast<void>(std::fprintf(trace_file,
+                                       "{\"name\":\"idle\",\"cat\":\"idle\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%u}%s\n",
+                                       ((the_record.kind == record_idle_begin) ? 'B' : 'E'),
+                                       timestamp,
+                                       thread,
+                                       separator));
+        break;
+
+      default:
+        static_cast<void>(std::fprintf(trace_file,
+                                       "{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%u,\"args\":{\"task\":%u,\"event\":%llu}}%s\n",
+                                       ((the_record.kind == record_event_set) ? "set_event" : "clear_event"),
+                                       timestamp,
+                                       thread,
+                                       task,
+                                       static_cast<unsigned long long>(the_record.value),
+                                       separator));
+        break;
+    }
+  }
+
+  static_cast<void>(std::fputs("],\"displayTimeUnit\":\"ms\"}\n", trace_file));
+
+  return (std::fclose(trace_file) == 0);
+}
+
+#endif // OS_TRACE
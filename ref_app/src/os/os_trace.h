@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef OS_TRACE_2020_10_17_H_
+  #define OS_TRACE_2020_10_17_H_
+
+  #include <cstddef>
+  #include <cstdint>
+  #include <os/os_cfg.h>
+
+  #if (OS_TRACE == 1)
+
+  namespace os
+  {
+    namespace trace
+    {
+      typedef enum enum_record_kind
+      {
+        record_task_begin,
+        record_task_end,
+        record_event_set,
+        record_event_clear,
+        record_idle_begin,
+        record_idle_end
+      }
+      record_kind_type;
+
+      // One trace record. The sequence number is cleared before the
+      // other fields are written and it is set after them, so that
+      // a record being overwritten while it is read can be detected
+      // and skipped by the reader.
+      struct record_type
+      {
+        tick_type          timepoint;
+        event_type         value;
+        std::uint32_t      sequence;
+        std::uint16_t      task;
+        std::uint8_t       thread;
+        std::uint8_t       kind;
+      };
+
+      static_assert((OS_TRACE_BUFFER_SIZE & (OS_TRACE_BUFFER_SIZE - 1U)) == 0U,
+                    "the size of the trace buffer must be a power of two");
+
+      // Register the trace dumper at exit (and at the quick exit
+      // of the host upon SIGINT and SIGTERM).
+      void initialize();
+
+      // Record an entry of the given task (or the running task).
+      void record(const record_kind_type kind,
+                  const std::uint_fast16_t task,
+                  const std::uint_fast8_t thread,
+                  const event_type value = event_type(0U));
+
+      void record_running_task(const record_kind_type kind,
+                               const event_type value = event_type(0U));
+
+      // Copy the records of the trace buffer (oldest first).
+      std::size_t get_records(record_type* records, const std::size_t record_count);
+
+      // Write the trace buffer as Chrome trace event JSON.
+      bool write_chrome_trace(const char* file_name);
+    }
+  }
+
+  #endif // OS_TRACE
+
+#endif // OS_TRACE_2020_10_17_H_
@@ -5,7 +5,16 @@
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <mcal_cpu.h>
 #include <mcal_wdg.h>
+#include <os/os.h>
+#include <sys/idle/sys_idle_cpu_load.h>
 
 namespace sys
 {
@@ -16,10 +25,194 @@ namespace sys
   }
 }
 
+namespace
+{
+  // Limit the wait in the idle task, so that the watchdog
+  // is serviced in time even if the next task is far away.
+  constexpr os::tick_type sys_idle_wait_ticks_max = os::timer_type::milliseconds(100U);
+
+  constexpr os::tick_type sys_idle_load_window_ticks = os::timer_type::milliseconds(100U);
+  constexpr std::size_t   sys_idle_load_window_count = 10U;
+
+  // The CPU load is measured by accounting the timer ticks that are
+  // spent idle in windows of 100ms. The idle time is the time spent
+  // in the idle task plus the time of the scheduler's scans that find
+  // no ready task. Such a scan is calibrated as the shortest gap that
+  // is observed between two calls of the idle task, and gaps up to
+  // twice as long (plus one tick) are counted as idle. So only tasks
+  // that are shorter than a scan are (wrongly) counted as idle time.
+  class sys_idle_cpu_load_meter final
+  {
+  public:
+    sys_idle_cpu_load_meter() : my_window_start     (0U),
+                                my_idle_begin       (0U),
+                                my_idle_end         (0U),
+                                my_idle_ticks       (0U),
+                                my_scan_ticks_min   ((std::numeric_limits<os::tick_type>::max)() / 4U),
+                                my_is_started       (false),
+                                my_loads_100ms      (),
+                                my_loads_1s         (),
+                                my_index_100ms      (0U),
+                                my_index_1s         (0U),
+                                my_count_100ms      (0U),
+                                my_count_1s         (0U),
+                                my_load             () { }
+
+    void idle_begin(const os::tick_type now)
+    {
+      if(my_is_started)
+      {
+        const os::tick_type gap = os::tick_type(now - my_idle_end);
+
+        my_scan_ticks_min = (std::min)(gap, my_scan_ticks_min);
+
+        if(gap <= os::tick_type(os::tick_type(my_scan_ticks_min * 2U) + 1U))
+        {
+          my_idle_ticks = os::tick_type(my_idle_ticks + gap);
+        }
+      }
+      else
+      {
+        my_is_started   = true;
+        my_window_start = now;
+      }
+
+      my_idle_begin = now;
+    }
+
+    void idle_end(const os::tick_type now)
+    {
+      my_idle_ticks = os::tick_type(my_idle_ticks + os::tick_type(now - my_idle_begin));
+      my_idle_end   = now;
+
+      const os::tick_type window_ticks = os::tick_type(now - my_window_start);
+
+      if(window_ticks >= sys_idle_load_window_ticks)
+      {
+        const os::tick_type busy_ticks = os::tick_type(window_ticks - (std::min)(my_idle_ticks, window_ticks));
+
+        close_window(static_cast<std::uint_least16_t>((std::uint_least64_t(busy_ticks) * 1000U) / window_ticks));
+
+        my_window_start = now;
+        my_idle_ticks   = 0U;
+      }
+    }
+
+    void close_overdue_windows(const os::tick_type now)
+    {
+      // At full load, the idle task does not run, and does not close
+      // the windows. So close the windows that are overdue, counting
+      // the time since the last idle end as busy. After the 10 times
+      // 10 windows of the 10s load, the further windows change nothing.
+      std::size_t closed_count = 0U;
+
+      while(my_is_started && (os::tick_type(now - my_window_start) >= sys_idle_load_window_ticks))
+      {
+        if(closed_count < (sys_idle_load_window_count * sys_idle_load_window_count))
+        {
+          const os::tick_type busy_ticks =
+            os::tick_type(sys_idle_load_window_ticks - (std::min)(my_idle_ticks, sys_idle_load_window_ticks));
+
+          close_window(static_cast<std::uint_least16_t>((std::uint_least64_t(busy_ticks) * 1000U) / sys_idle_load_window_ticks));
+
+          ++closed_count;
+        }
+
+        my_window_start = os::tick_type(my_window_start + sys_idle_load_window_ticks);
+        my_idle_ticks   = 0U;
+      }
+    }
+
+    const sys::idle::cpu_load_type& get_load() const { return my_load; }
+
+  private:
+    typedef std::array<std::uint_least16_t, sys_idle_load_window_count> load_array_type;
+
+    os::tick_type            my_window_start;
+    os::tick_type            my_idle_begin;
+    os::tick_type            my_idle_end;
+    os::tick_type            my_idle_ticks;
+    os::tick_type            my_scan_ticks_min;
+    bool                     my_is_started;
+    load_array_type          my_loads_100ms;
+    load_array_type          my_loads_1s;
+    std::size_t              my_index_100ms;
+    std::size_t              my_index_1s;
+    std::size_t              my_count_100ms;
+    std::size_t              my_count_1s;
+    sys::idle::cpu_load_type my_load;
+
+    static std::uint_least16_t mean(const load_array_type& loads, const std::size_t count)
+    {
+      return static_cast<std::uint_least16_t>(  std::accumulate(loads.cbegin(), loads.cbegin() + count, std::uint_least32_t(0U))
+                                              / std::uint_least32_t(count));
+    }
+
+    void close_window(const std::uint_least16_t load_100ms)
+    {
+      my_load.load_100ms = load_100ms;
+      my_load.load_peak  = (std::max)(load_100ms, my_load.load_peak);
+
+      // Slide the 1s load over the last 10 windows of 100ms.
+      my_loads_100ms[my_index_100ms] = load_100ms;
+
+      ++my_index_100ms;
+
+      const bool second_is_complete = (my_index_100ms == sys_idle_load_window_count);
+
+      if(second_is_complete)
+      {
+        my_index_100ms = 0U;
+      }
+
+      my_count_100ms = (std::min)(std::size_t(my_count_100ms + 1U), sys_idle_load_window_count);
+
+      my_load.load_1s = mean(my_loads_100ms, my_count_100ms);
+
+      // Slide the 10s load over the last 10 loads of 1s.
+      if(second_is_complete)
+      {
+        my_loads_1s[my_index_1s] = my_load.load_1s;
+
+        my_index_1s = ((my_index_1s + 1U) % sys_idle_load_window_count);
+        my_count_1s = (std::min)(std::size_t(my_count_1s + 1U), sys_idle_load_window_count);
+
+        my_load.load_10s = mean(my_loads_1s, my_count_1s);
+      }
+    }
+  };
+
+  sys_idle_cpu_load_meter sys_idle_cpu_load;
+}
+
+void sys::idle::get_cpu_load(cpu_load_type& cpu_load)
+{
+  sys_idle_cpu_load.close_overdue_windows(os::timer_type::get_mark());
+
+  cpu_load = sys_idle_cpu_load.get_load();
+}
+
 void sys::idle::task_init() { }
 
 void sys::idle::task_func()
 {
+  sys_idle_cpu_load.idle_begin(os::timer_type::get_mark());
+
+  if(mcal::cpu::wait_for_wakeup_is_supported())
+  {
+    // Wait (without spinning) until the next task becomes ready,
+    // or until a wakeup is requested, for instance by os::set_event.
+    const os::tick_type wait_ticks =
+      (std::min)(os::get_ticks_until_next_task(), sys_idle_wait_ticks_max);
+
+    if(wait_ticks != os::tick_type(0U))
+    {
+      mcal::cpu::wait_for_wakeup(static_cast<std::uint32_t>(wait_ticks / os::timer_type::microseconds(1U)));
+    }
+  }
+
   // Service the watchdog.
   mcal::wdg::secure::trigger();
+
+  sys_idle_cpu_load.idle_end(os::timer_type::get_mark());
 }
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SYS_IDLE_CPU_LOAD_2020_10_17_H_
+  #define SYS_IDLE_CPU_LOAD_2020_10_17_H_
+
+  #include <cstdint>
+
+  namespace sys
+  {
+    namespace idle
+    {
+      // The CPU load in permille, measured by the idle task.
+      // The 100ms load is the one of the last completed window.
+      // The 1s and 10s loads slide over the last 10 windows
+      // of 100ms and 1s, respectively. The peak load is the
+      // highest 100ms load since the start.
+      struct cpu_load_type
+      {
+        std::uint_least16_t load_100ms;
+        std::uint_least16_t load_1s;
+        std::uint_least16_t load_10s;
+        std::uint_least16_t load_peak;
+      };
+
+      // Get the CPU load. Call this from a task (or from the idle task)
+      // of the scheduler thread that runs the idle task.
+      void get_cpu_load(cpu_load_type& cpu_load);
+    }
+  }
+
+#endif // SYS_IDLE_CPU_LOAD_2020_10_17_H_
@@ -5,6 +5,9 @@
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <array>
+#include <os/os.h>
+#include <sys/idle/sys_idle_cpu_load.h>
 
 namespace sys
 {
@@ -12,13 +15,38 @@ namespace sys
   {
     void task_init();
     void task_func();
+
+    #if (OS_TASK_PROFILING == 1)
+    // The snapshot of the task statistics is refreshed in each
+    // monitor cycle, so that it can be read at runtime, for instance
+    // with a debugger or via the debug monitor.
+    extern std::array<os::task_statistics, OS_TASK_COUNT> task_statistics;
+    #endif
+
+    // The snapshot of the CPU load that is measured in the idle task.
+    extern sys::idle::cpu_load_type cpu_load;
   }
 }
 
+#if (OS_TASK_PROFILING == 1)
+std::array<os::task_statistics, OS_TASK_COUNT> sys::mon::task_statistics;
+#endif
+
+sys::idle::cpu_load_type sys::mon::cpu_load;
+
 void sys::mon::task_init()
 {
 }
 
 void sys::mon::task_func()
 {
+  sys::idle::get_cpu_load(cpu_load);
+
+  #if (OS_TASK_PROFILING == 1)
+  for(std::size_t task_index = 0U; task_index < OS_TASK_COUNT; ++task_index)
+  {
+    static_cast<void>(os::get_task_statistics(static_cast<os::task_id_type>(task_index),
+                                              task_statistics[task_index]));
+  }
+  #endif
 }
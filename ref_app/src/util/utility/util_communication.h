@@ -19,6 +19,10 @@
     class communication_base : private util::noncopyable
     {
     public:
+      // The completion function of an asynchronous transfer,
+      // which is called with the result and the payload of the transfer.
+      typedef void(*transfer_completion_type)(const bool transfer_is_ok, const std::uintptr_t payload);
+
       virtual ~communication_base() = default;
 
       virtual bool recv(std::uint8_t& byte_to_recv) = 0;
@@ -45,8 +49,77 @@
         return send_result;
       }
 
+      // A buffer of bytes is sent with one block transfer.
+      bool send_n(const std::uint8_t* first, const std::uint8_t* last)
+      {
+        return transceive(first, nullptr, std::size_t(last - first));
+      }
+
+      bool send_n(std::uint8_t* first, std::uint8_t* last)
+      {
+        return transceive(first, nullptr, std::size_t(last - first));
+      }
+
+      // Receive a buffer of bytes with one block transfer,
+      // whereby the bytes 0xFF are sent.
+      bool recv_n(std::uint8_t* first, std::uint8_t* last)
+      {
+        return transceive(nullptr, first, std::size_t(last - first));
+      }
+
       virtual bool send(const std::uint8_t byte_to_send) = 0;
 
+      // Send count bytes and receive the count bytes that are
+      // received meanwhile. Without a send buffer, the bytes 0xFF
+      // are sent, and without a receive buffer, the received bytes
+      // are discarded. The default block transfer sends and receives
+      // one byte at a time. Without a receive buffer it only sends,
+      // so that the default send_n is the former send-only loop.
+      // Drivers that can transfer a block (for instance, without
+      // a virtual call per byte) override it.
+      virtual bool transceive(const std::uint8_t* p_send,
+                              std::uint8_t* p_recv,
+                              const std::size_t count)
+      {
+        bool transfer_result = true;
+
+        for(std::size_t index = 0U; index < count; ++index)
+        {
+          transfer_result &= this->send((p_send != nullptr) ? p_send[index] : UINT8_C(0xFF));
+
+          if(p_recv != nullptr)
+          {
+            transfer_result &= this->recv(p_recv[index]);
+          }
+        }
+
+        return transfer_result;
+      }
+
+      // Start a block transfer and call the completion function
+      // when it is done. The buffers must remain valid until then.
+      // The default asynchronous transfer is done in the call,
+      // so the completion is called before the function returns.
+      // Drivers that can transfer with DMA override it and call
+      // the completion from the interrupt (or defer it with
+      // os::post_deferred_work). The return value tells if the
+      // transfer has been started.
+      virtual bool transceive_async(const std::uint8_t* p_send,
+                                    std::uint8_t* p_recv,
+                                    const std::size_t count,
+                                    transfer_completion_type completion,
+                                    const std::uintptr_t payload = 0U)
+      {
+        const bool transfer_result = transceive(p_send, p_recv, count);
+
+        if(completion != nullptr)
+        {
+          completion(transfer_result, payload);
+        }
+
+        return true;
+      }
+
     protected:
       communication_base() = default;
 
@@ -105,6 +178,22 @@
         return my_com_channels[my_index]->recv(byte_to_recv);
       }
 
+      virtual bool transceive(const std::uint8_t* p_send,
+                              std::uint8_t* p_recv,
+                              const std::size_t count)
+      {
+        return my_com_channels[my_index]->transceive(p_send, p_recv, count);
+      }
+
+      virtual bool transceive_async(const std::uint8_t* p_send,
+                                    std::uint8_t* p_recv,
+                                    const std::size_t count,
+                                    transfer_completion_type completion,
+                                    const std::uintptr_t payload = 0U)
+      {
+        return my_com_channels[my_index]->transceive_async(p_send, p_recv, count, completion, payload);
+      }
+
       virtual void   select() { my_com_channels[my_index]->select(); }
       virtual void deselect() { my_com_channels[my_index]->deselect(); }
 
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////
-//  Copyright Christopher Kormanyos 2014.
+//  Copyright Christopher Kormanyos 2014 - 2020.
 //  Distributed under the Boost Software License,
 //  Version 1.0. (See accompanying file LICENSE_1_0.txt
 //  or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -8,9 +8,32 @@
 #ifndef UTIL_STOPWATCH_2014_01_07_H_
   #define UTIL_STOPWATCH_2014_01_07_H_
 
+  #include <chrono>
+  #include <cstdint>
+  #include <util/utility/util_time.h>
+
   namespace util
   {
-    template<typename clock_type>
+    // A chrono clock on the system tick of util::timer. It follows
+    // the virtual time of the host when this is selected in mcal_gpt.
+    struct timer_clock final
+    {
+      typedef std::chrono::microseconds              duration;
+      typedef duration::rep                          rep;
+      typedef duration::period                       period;
+      typedef std::chrono::time_point<timer_clock>   time_point;
+
+      static constexpr bool is_steady = true;
+
+      static time_point now()
+      {
+        typedef util::timer<mcal::gpt::value_type> timer_type;
+
+        return time_point(duration(static_cast<rep>(timer_type::get_mark())));
+      }
+    };
+
+    template<typename clock_type = timer_clock>
     class stopwatch final
     {
     public:
@@ -49,7 +72,7 @@
     };
   }
 
-  //  util::stopwatch<std::chrono::high_resolution_clock> my_stopwatch;
+  //  util::stopwatch<> my_stopwatch;
   //  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(my_stopwatch.elapsed()).count();
   //  const auto elapsed = std::chrono::duration_cast<std::chrono::duration<float>>(my_stopwatch.elapsed()).count();
 
@@ -80,6 +80,29 @@
         return (delta <= timer_mask);
       }
 
+      tick_type get_ticks_until_timeout(const tick_type timepoint) const
+      {
+        // Obtain the ticks from the timepoint until the timeout,
+        // which is zero if the timeout has already occurred.
+        return (timeout_of_specific_timepoint(timepoint) ? tick_type(0U)
+                                                         : tick_type(my_tick - timepoint));
+      }
+
+      tick_type get_ticks_since_timeout(const tick_type timepoint) const
+      {
+        // Obtain the ticks from the timeout until the timepoint,
+        // which is only meaningful if the timeout has occurred.
+        return tick_type(timepoint - my_tick);
+      }
+
+      bool timeout_is_before(const timer& other) const
+      {
+        // Compare the timeout points of two timers in a wrap-safe manner.
+        const tick_type delta = my_tick - other.my_tick;
+
+        return (delta > timer_mask);
+      }
+
       void set_mark()
       {
         my_tick = my_now();
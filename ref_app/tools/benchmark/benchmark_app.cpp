@@ -0,0 +1,708 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Host benchmark runner of all of the app/benchmark kernels.
+// The kernels are compiled with APP_BENCHMARK_TYPE_ALL. One operation
+// is one call of the kernel's run function, in other words the work
+// of one call of app::benchmark::task_func on the target. Each kernel
+// is called for the warm-up, then the batch size is calibrated, which
+// is the number of calls that take at least 1 us, so that the resolution
+// and the overhead of the steady clock do not dominate the short kernels.
+// Each of the repetitions times one batch, and its sample is the time
+// of the batch divided by the batch size, in ns with fractions of ns. The runner prints a table of
+// the batch size, the minimum, median, 99th percentile and maximum time
+// per operation, the operations per second and the result, and writes
+// the statistics and the samples as JSON. The exit code is non-zero
+// if a kernel fails.
+//
+// On Linux, the hardware performance counters of benchmark_perf_counters.h
+// are read in a second, untimed pass of the repetitions. The runner
+// reports the cycles, instructions, branch misses, L1D and LLC misses
+// per operation, the instructions per cycle, and the cycles per byte
+// or per limb of the kernels which have a work size. Counters which
+// are unavailable are reported as such. Use --no-counters to skip them.
+//
+// With --baseline file, the samples of each kernel are compared with
+// the baseline of benchmark_baseline.h having the same kernel, variant
+// and compiler. A kernel regresses if its median is more than the
+// threshold (default 5%) slower than the baseline median, and if the
+// Mann-Whitney U test finds it slower at the significance level alpha
+// (default 0.01). The runner prints the comparison and exits with 2
+// if a kernel regresses. With --update-baseline, the samples of this
+// run replace the ones in the baseline file instead. The baseline is
+// meant to be kept next to app/benchmark, for instance in
+// src/app/benchmark/app_benchmark_baseline.txt. Since the times
+// depend on the machine, it should be recorded on the machine that
+// runs the comparison.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   g++ -std=c++17 -O2 -DAPP_BENCHMARK_TYPE=APP_BENCHMARK_TYPE_ALL -I../../src -I../../src/mcal/host -I../../src/util/STL_C++XX_stdfloat benchmark_app.cpp ../../src/app/benchmark/app_benchmark_*.cpp -o benchmark_app
+//   ./benchmark_app [--warmup N] [--repetitions N] [--kernel name] [--json file] [--no-counters]
+//                   [--baseline file [--update-baseline] [--threshold percent] [--alpha p]]
+// The JSON is written to stdout with --json -.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <app/benchmark/app_benchmark.h>
+
+#include "benchmark_baseline.h"
+#include "benchmark_perf_counters.h"
+
+namespace
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  typedef benchmark::perf_counters perf_counters_type;
+
+  // The work size is the number of work units per operation,
+  // for instance the 9 bytes of the crc or the 8 limbs (of 32 bits)
+  // of the 256-bit wide integers. It is 0 if there is no such unit.
+  struct kernel_type
+  {
+    const char* name;
+    std::string variant;
+    bool(*run)();
+    std::size_t work_size;
+    const char* work_unit;
+  };
+
+  std::string make_variant(const char* format, const unsigned value_1, const unsigned value_2)
+  {
+    char variant[64U];
+
+    static_cast<void>(std::snprintf(variant, sizeof(variant), format, value_1, value_2));
+
+    return std::string(variant);
+  }
+
+  // The variants of the parameterized kernels are made of the
+  // parameters of app_benchmark.h, so that a changed kernel
+  // is not compared with the baseline of the former one.
+  const std::string crc_variant          = make_variant("crc32_mpeg2_%u_bytes", app::benchmark::crc_data_size, 0U);
+  const std::string filter_variant       = make_variant("fir_order_%u_int%u",   app::benchmark::filter_order,            app::benchmark::filter_sample_digits);
+  const std::string wide_integer_variant = make_variant("uint%u_limb%u",        app::benchmark::wide_integer_digits,     app::benchmark::wide_integer_limb_digits);
+  const std::string pi_spigot_variant    = make_variant("pi_spigot_%u_%u",      app::benchmark::pi_spigot_result_digits, app::benchmark::pi_spigot_loop_digits);
+
+  constexpr std::size_t wide_integer_limb_count = app::benchmark::wide_integer_digits / app::benchmark::wide_integer_limb_digits;
+
+  const kernel_type kernels[] =
+  {
+    { "complex",      "complex_float32",    app::benchmark::run_complex,      0U,                            nullptr },
+    { "crc",          crc_variant,          app::benchmark::run_crc,          app::benchmark::crc_data_size, "byte"  },
+    { "fast_math",    "float32",            app::benchmark::run_fast_math,    0U,                            nullptr },
+    { "filter",       filter_variant,       app::benchmark::run_filter,       0U,                            nullptr },
+    { "fixed_point",  "fixed_point_int32",  app::benchmark::run_fixed_point,  0U,                            nullptr },
+    { "float",        "float32",            app::benchmark::run_float,        0U,                            nullptr },
+    { "wide_integer", wide_integer_variant, app::benchmark::run_wide_integer, wide_integer_limb_count,       "limb"  },
+    { "pi_spigot",    pi_spigot_variant,    app::benchmark::run_pi_spigot,    0U,                            nullptr }
+  };
+
+  struct result_type
+  {
+    const kernel_type*         kernel;
+    const char*                name;
+    bool                       result_is_ok;
+    std::size_t                batch_size;
+    double                     time_min;
+    double                     time_median;
+    double                     time_p99;
+    double                     time_max;
+    double                     ops_per_second;
+    std::vector<double>        samples;
+    bool                       counters_are_read;
+    double                     counters[perf_counters_type::counter_count];
+    bool                       counter_is_valid[perf_counters_type::counter_count];
+  };
+
+  std::uint64_t get_time_ns()
+  {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count());
+  }
+
+  // The batch time of the calibration and the limit of the batch size.
+  constexpr std::uint64_t batch_time_min = 1000U;
+  constexpr std::size_t   batch_size_max = std::size_t(1UL << 20U);
+
+  double get_percentile(const std::vector<double>& sorted_samples, const unsigned percent)
+  {
+    // The nearest-rank percentile of the sorted samples.
+    const std::size_t rank = ((sorted_samples.size() * percent) + 99U) / 100U;
+
+    return sorted_samples[((rank != 0U) ? (rank - 1U) : 0U)];
+  }
+
+  bool run_batch(const kernel_type& kernel, const std::size_t batch_size)
+  {
+    bool result_is_ok = true;
+
+    for(std::size_t index = 0U; index < batch_size; ++index)
+    {
+      result_is_ok &= kernel.run();
+    }
+
+    return result_is_ok;
+  }
+
+  std::size_t calibrate_batch_size(const kernel_type& kernel, result_type& result)
+  {
+    // Double the batch size until a batch takes at least batch_time_min.
+    std::size_t batch_size = 1U;
+
+    for(;;)
+    {
+      const std::uint64_t start = get_time_ns();
+
+      result.result_is_ok &= run_batch(kernel, batch_size);
+
+      const std::uint64_t stop = get_time_ns();
+
+      if(((stop - start) >= batch_time_min) || (batch_size >= batch_size_max))
+      {
+        break;
+      }
+
+      batch_size *= 2U;
+    }
+
+    return batch_size;
+  }
+
+  void read_counters(const kernel_type& kernel,
+                     const std::size_t repetition_count,
+                     perf_counters_type& counters,
+                     result_type& result)
+  {
+    // Count the batches of the repetitions in a pass without
+    // the timer reads, and keep the counts per operation.
+    perf_counters_type::values_type values;
+
+    counters.start();
+
+    for(std::size_t index = 0U; index < repetition_count; ++index)
+    {
+      result.result_is_ok &= run_batch(kernel, result.batch_size);
+    }
+
+    counters.stop(values);
+
+    result.counters_are_read = true;
+
+    for(std::size_t index = 0U; index < std::size_t(perf_counters_type::counter_count); ++index)
+    {
+      result.counter_is_valid[index] = values.is_valid[index];
+      result.counters        [index] = double(values.value[index]) / (double(repetition_count) * double(result.batch_size));
+    }
+  }
+
+  result_type run_kernel(const kernel_type& kernel,
+                         const std::size_t warmup_count,
+                         const std::size_t repetition_count,
+                         perf_counters_type* counters)
+  {
+    result_type result;
+
+    result.kernel            = &kernel;
+    result.name              = kernel.name;
+    result.result_is_ok      = true;
+    result.counters_are_read = false;
+
+    for(std::size_t index = 0U; index < warmup_count; ++index)
+    {
+      result.result_is_ok &= kernel.run();
+    }
+
+    result.batch_size = calibrate_batch_size(kernel, result);
+
+    result.samples.resize(repetition_count);
+
+    std::uint64_t time_total = 0U;
+
+    for(std::size_t index = 0U; index < repetition_count; ++index)
+    {
+      const std::uint64_t start = get_time_ns();
+
+      const bool run_is_ok = run_batch(kernel, result.batch_size);
+
+      const std::uint64_t stop = get_time_ns();
+
+      result.result_is_ok &= run_is_ok;
+
+      // The sample is the time per operation.
+      result.samples[index] = double(stop - start) / double(result.batch_size);
+
+      time_total += (stop - start);
+    }
+
+    std::vector<double> sorted_samples(result.samples);
+
+    std::sort(sorted_samples.begin(), sorted_samples.end());
+
+    result.time_min       = sorted_samples.front();
+    result.time_median    = get_percentile(sorted_samples, 50U);
+    result.time_p99       = get_percentile(sorted_samples, 99U);
+    result.time_max       = sorted_samples.back();
+    result.ops_per_second = ((time_total != 0U) ? ((double(repetition_count) * double(result.batch_size) * 1.0E9) / double(time_total)) : 0.0);
+
+    if((counters != nullptr) && counters->is_available())
+    {
+      read_counters(kernel, repetition_count, *counters, result);
+    }
+
+    return result;
+  }
+
+  void print_table(std::FILE* table_file, const std::vector<result_type>& results)
+  {
+    static_cast<void>(std::fprintf(table_file,
+                                   "%-14s %8s %12s %12s %12s %12s %14s %6s\n",
+                                   "kernel", "batch", "min ns", "median ns", "p99 ns", "max ns", "ops/s", "result"));
+
+    for(const result_type& result : results)
+    {
+      static_cast<void>(std::fprintf(table_file,
+                                     "%-14s %8llu %12.1f %12.1f %12.1f %12.1f %14.1f %6s\n",
+                                     result.name,
+                                     static_cast<unsigned long long>(result.batch_size),
+                                     result.time_min,
+                                     result.time_median,
+                                     result.time_p99,
+                                     result.time_max,
+                                     result.ops_per_second,
+                                     (result.result_is_ok ? "pass" : "FAIL")));
+    }
+  }
+
+  bool get_counter(const result_type& result,
+                   const perf_counters_type::counter_type counter,
+                   double& value)
+  {
+    value = result.counters[counter];
+
+    return (result.counters_are_read && result.counter_is_valid[counter]);
+  }
+
+  bool get_instructions_per_cycle(const result_type& result, double& value)
+  {
+    double cycles;
+    double instructions;
+
+    const bool value_is_valid =
+         get_counter(result, perf_counters_type::counter_cycles,       cycles)
+      && get_counter(result, perf_counters_type::counter_instructions, instructions)
+      && (cycles != 0.0);
+
+    value = (value_is_valid ? (instructions / cycles) : 0.0);
+
+    return value_is_valid;
+  }
+
+  bool get_cycles_per_work_unit(const result_type& result, double& value)
+  {
+    double cycles;
+
+    const bool value_is_valid =
+         get_counter(result, perf_counters_type::counter_cycles, cycles)
+      && (result.kernel->work_size != 0U);
+
+    value = (value_is_valid ? (cycles / double(result.kernel->work_size)) : 0.0);
+
+    return value_is_valid;
+  }
+
+  void print_value(std::FILE* table_file, const bool value_is_valid, const double value, const int width, const int precision)
+  {
+    if(value_is_valid)
+    {
+      static_cast<void>(std::fprintf(table_file, " %*.*f", width, precision, value));
+    }
+    else
+    {
+      static_cast<void>(std::fprintf(table_file, " %*s", width, "-"));
+    }
+  }
+
+  void print_counter_table(std::FILE* table_file,
+                           const std::vector<result_type>& results,
+                           const perf_counters_type& counters)
+  {
+    if(counters.is_available() == false)
+    {
+      static_cast<void>(std::fprintf(table_file,
+                                     "hardware counters unavailable: %s\n",
+                                     ((counters.get_error() != 0) ? std::strerror(counters.get_error()) : "not supported")));
+
+      return;
+    }
+
+    static_cast<void>(std::fprintf(table_file,
+                                   "\n%-14s %12s %12s %6s %12s %12s %12s %16s\n",
+                                   "kernel", "cycles/op", "instr/op", "IPC", "br-miss/op", "L1D-miss/op", "LLC-miss/op", "cycles/unit"));
+
+    for(const result_type& result : results)
+    {
+      static_cast<void>(std::fprintf(table_file, "%-14s", result.name));
+
+      double value;
+
+      bool value_is_valid = get_counter(result, perf_counters_type::counter_cycles, value);
+      print_value(table_file, value_is_valid, value, 12, 1);
+
+      value_is_valid = get_counter(result, perf_counters_type::counter_instructions, value);
+      print_value(table_file, value_is_valid, value, 12, 1);
+
+      value_is_valid = get_instructions_per_cycle(result, value);
+      print_value(table_file, value_is_valid, value, 6, 2);
+
+      value_is_valid = get_counter(result, perf_counters_type::counter_branch_misses, value);
+      print_value(table_file, value_is_valid, value, 12, 2);
+
+      value_is_valid = get_counter(result, perf_counters_type::counter_l1d_misses, value);
+      print_value(table_file, value_is_valid, value, 12, 2);
+
+      value_is_valid = get_counter(result, perf_counters_type::counter_llc_misses, value);
+      print_value(table_file, value_is_valid, value, 12, 2);
+
+      value_is_valid = get_cycles_per_work_unit(result, value);
+
+      if(value_is_valid)
+      {
+        static_cast<void>(std::fprintf(table_file, " %11.2f/%-4s\n", value, result.kernel->work_unit));
+      }
+      else
+      {
+        static_cast<void>(std::fprintf(table_file, " %16s\n", "-"));
+      }
+    }
+  }
+
+  void write_json_value(std::FILE* json_file, const char* name, const bool value_is_valid, const double value)
+  {
+    if(value_is_valid)
+    {
+      static_cast<void>(std::fprintf(json_file, "\"%s\":%.3f", name, value));
+    }
+    else
+    {
+      static_cast<void>(std::fprintf(json_file, "\"%s\":null", name));
+    }
+  }
+
+  void write_json_counters(std::FILE* json_file, const result_type& result)
+  {
+    if(result.counters_are_read == false)
+    {
+      static_cast<void>(std::fputs(",\"counters\":null", json_file));
+
+      return;
+    }
+
+    static_cast<void>(std::fputs(",\"counters\":{", json_file));
+
+    double value;
+
+    for(std::size_t index = 0U; index < std::size_t(perf_counters_type::counter_count); ++index)
+    {
+      const perf_counters_type::counter_type counter = static_cast<perf_counters_type::counter_type>(index);
+
+      const bool value_is_valid = get_counter(result, counter, value);
+
+      write_json_value(json_file, perf_counters_type::get_name(counter), value_is_valid, value);
+
+      static_cast<void>(std::fputc(',', json_file));
+    }
+
+    bool value_is_valid = get_instructions_per_cycle(result, value);
+
+    write_json_value(json_file, "ipc", value_is_valid, value);
+
+    if(result.kernel->work_size != 0U)
+    {
+      char name[32U];
+
+      static_cast<void>(std::snprintf(name, sizeof(name), "cycles_per_%s", result.kernel->work_unit));
+
+      value_is_valid = get_cycles_per_work_unit(result, value);
+
+      static_cast<void>(std::fputc(',', json_file));
+
+      write_json_value(json_file, name, value_is_valid, value);
+    }
+
+    static_cast<void>(std::fputc('}', json_file));
+  }
+
+  bool write_json(const char* file_name,
+                  const std::vector<result_type>& results,
+                  const std::size_t warmup_count,
+                  const std::size_t repetition_count)
+  {
+    const bool is_stdout = (std::strcmp(file_name, "-") == 0);
+
+    std::FILE* json_file = (is_stdout ? stdout : std::fopen(file_name, "w"));
+
+    if(json_file == nullptr)
+    {
+      return false;
+    }
+
+    static_cast<void>(std::fprintf(json_file,
+                                   "{\"warmup\":%llu,\"repetitions\":%llu,\"unit\":\"ns\",\"kernels\":[\n",
+                                   static_cast<unsigned long long>(warmup_count),
+                                   static_cast<unsigned long long>(repetition_count)));
+
+    for(std::size_t result_index = 0U; result_index < results.size(); ++result_index)
+    {
+      const result_type& result = results[result_index];
+
+      static_cast<void>(std::fprintf(json_file,
+                                     "{\"name\":\"%s\",\"pass\":%s,\"batch\":%llu,\"min\":%.3f,\"median\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"ops_per_second\":%.1f",
+                                     result.name,
+                                     (result.result_is_ok ? "true" : "false"),
+                                     static_cast<unsigned long long>(result.batch_size),
+                                     result.time_min,
+                                     result.time_median,
+                                     result.time_p99,
+                                     result.time_max,
+                                     result.ops_per_second));
+
+      write_json_counters(json_file, result);
+
+      static_cast<void>(std::fputs(",\"samples\":[", json_file));
+
+      for(std::size_t index = 0U; index < result.samples.size(); ++index)
+      {
+        static_cast<void>(std::fprintf(json_file,
+                                       "%s%.3f",
+                                       ((index != 0U) ? "," : ""),
+                                       result.samples[index]));
+      }
+
+      static_cast<void>(std::fprintf(json_file, "]}%s\n", ((result_index + 1U < results.size()) ? "," : "")));
+    }
+
+    static_cast<void>(std::fputs("]}\n", json_file));
+
+    return (is_stdout ? (std::fflush(json_file) == 0) : (std::fclose(json_file) == 0));
+  }
+
+  bool compare_with_baseline(std::FILE* table_file,
+                             const std::vector<result_type>& results,
+                             const benchmark::baseline_type& baseline,
+                             const std::string& compiler,
+                             const double threshold,
+                             const double alpha)
+  {
+    // Print the comparison with the baseline,
+    // and return false if one of the kernels regresses.
+    static_cast<void>(std::fprintf(table_file, "\nbaseline comparison (%s, threshold %.1f%%, alpha %g)\n", compiler.c_str(), threshold, alpha));
+
+    static_cast<void>(std::fprintf(table_file,
+                                   "%-14s %-22s %12s %12s %9s %10s %10s  %s\n",
+                                   "kernel", "variant", "base ns", "median ns", "change", "p slower", "p faster", "verdict"));
+
+    bool none_regresses = true;
+
+    for(const result_type& result : results)
+    {
+      const auto it = std::find_if(baseline.cbegin(),
+                                   baseline.cend(),
+                                   [&result, &compiler](const benchmark::baseline_entry_type& entry)
+                                   {
+                                     return entry.has_key(result.name, result.kernel->variant, compiler);
+                                   });
+
+      if(it == baseline.cend())
+      {
+        static_cast<void>(std::fprintf(table_file,
+                                       "%-14s %-22s %12s %12.1f %9s %10s %10s  %s\n",
+                                       result.name,
+                                       result.kernel->variant.c_str(),
+                                       "-",
+                                       result.time_median,
+                                       "-",
+                                       "-",
+                                       "-",
+                                       "no baseline"));
+
+        continue;
+      }
+
+      const benchmark::mann_whitney_result_type test = benchmark::mann_whitney_test(it->samples, result.samples);
+
+      const double change =
+        ((it->median != 0.0) ? (((result.time_median - it->median) * 100.0) / it->median) : 0.0);
+
+      const bool is_slower = ((test.p_greater < alpha) && (change >  threshold));
+      const bool is_faster = ((test.p_less    < alpha) && (change < -threshold));
+
+      none_regresses &= (is_slower == false);
+
+      static_cast<void>(std::fprintf(table_file,
+                                     "%-14s %-22s %12.1f %12.1f %+8.1f%% %10.4f %10.4f  %s\n",
+                                     result.name,
+                                     result.kernel->variant.c_str(),
+                                     it->median,
+                                     result.time_median,
+                                     change,
+                                     test.p_greater,
+                                     test.p_less,
+                                     (is_slower ? "REGRESSION" : (is_faster ? "faster" : "ok"))));
+    }
+
+    return none_regresses;
+  }
+
+  void print_usage()
+  {
+    static_cast<void>(std::fputs("usage: benchmark_app [--warmup N] [--repetitions N] [--kernel name] [--json file] [--no-counters]\n"
+                                 "                     [--baseline file [--update-baseline] [--threshold percent] [--alpha p]]\n", stderr));
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t warmup_count        = 100U;
+  std::size_t repetition_count    = 1000U;
+  const char* kernel_name         = nullptr;
+  const char* json_file_name      = nullptr;
+  bool        counters_are_used   = true;
+  const char* baseline_file_name  = nullptr;
+  bool        baseline_is_updated = false;
+  double      threshold           = 5.0;
+  double      alpha               = 0.01;
+
+  for(int arg_index = 1; arg_index < argc; ++arg_index)
+  {
+    const char* arg = argv[arg_index];
+
+    const bool has_value = (arg_index + 1 < argc);
+
+    if     ((std::strcmp(arg, "--warmup")          == 0) && has_value) { warmup_count        = std::strtoul(argv[++arg_index], nullptr, 10); }
+    else if((std::strcmp(arg, "--repetitions")     == 0) && has_value) { repetition_count    = std::strtoul(argv[++arg_index], nullptr, 10); }
+    else if((std::strcmp(arg, "--kernel")          == 0) && has_value) { kernel_name         = argv[++arg_index]; }
+    else if((std::strcmp(arg, "--json")            == 0) && has_value) { json_file_name      = argv[++arg_index]; }
+    else if (std::strcmp(arg, "--no-counters")     == 0)               { counters_are_used   = false; }
+    else if((std::strcmp(arg, "--baseline")        == 0) && has_value) { baseline_file_name  = argv[++arg_index]; }
+    else if (std::strcmp(arg, "--update-baseline") == 0)               { baseline_is_updated = true; }
+    else if((std::strcmp(arg, "--threshold")       == 0) && has_value) { threshold           = std::strtod(argv[++arg_index], nullptr); }
+    else if((std::strcmp(arg, "--alpha")           == 0) && has_value) { alpha               = std::strtod(argv[++arg_index], nullptr); }
+    else
+    {
+      print_usage();
+
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A baseline is not updated with more samples than it can read.
+  if(   (repetition_count == 0U)
+     || (baseline_is_updated && (baseline_file_name == nullptr))
+     || (baseline_is_updated && (repetition_count > benchmark::baseline_sample_count_max)))
+  {
+    print_usage();
+
+    return EXIT_FAILURE;
+  }
+
+  perf_counters_type counters;
+
+  std::vector<result_type> results;
+
+  for(const kernel_type& kernel : kernels)
+  {
+    if((kernel_name == nullptr) || (std::strcmp(kernel_name, kernel.name) == 0))
+    {
+      results.push_back(run_kernel(kernel, warmup_count, repetition_count, (counters_are_used ? &counters : nullptr)));
+    }
+  }
+
+  if(results.empty())
+  {
+    static_cast<void>(std::fprintf(stderr, "benchmark_app: unknown kernel %s\n", kernel_name));
+
+    return EXIT_FAILURE;
+  }
+
+  // With the JSON on stdout, the table goes to stderr.
+  const bool json_is_stdout = ((json_file_name != nullptr) && (std::strcmp(json_file_name, "-") == 0));
+
+  std::FILE* table_file = (json_is_stdout ? stderr : stdout);
+
+  print_table(table_file, results);
+
+  if(counters_are_used)
+  {
+    print_counter_table(table_file, results, counters);
+  }
+
+  bool result_is_ok = true;
+
+  for(const result_type& result : results)
+  {
+    result_is_ok &= result.result_is_ok;
+  }
+
+  if((json_file_name != nullptr) && (write_json(json_file_name, results, warmup_count, repetition_count) == false))
+  {
+    static_cast<void>(std::fprintf(stderr, "benchmark_app: cannot write %s\n", json_file_name));
+
+    result_is_ok = false;
+  }
+
+  bool none_regresses = true;
+
+  if(baseline_file_name != nullptr)
+  {
+    benchmark::baseline_type baseline;
+
+    const std::string compiler = benchmark::get_compiler_name();
+
+    if(benchmark::read_baseline(baseline_file_name, baseline) == false)
+    {
+      static_cast<void>(std::fprintf(stderr, "benchmark_app: cannot read the baseline %s\n", baseline_file_name));
+
+      result_is_ok = false;
+    }
+    else if(baseline_is_updated)
+    {
+      for(const result_type& result : results)
+      {
+        benchmark::baseline_entry_type entry;
+
+        entry.kernel   = result.name;
+        entry.variant  = result.kernel->variant;
+        entry.compiler = compiler;
+        entry.median   = result.time_median;
+        entry.samples  = result.samples;
+
+        benchmark::update_baseline(baseline, std::move(entry));
+      }
+
+      if(benchmark::write_baseline(baseline_file_name, baseline) == false)
+      {
+        static_cast<void>(std::fprintf(stderr, "benchmark_app: cannot write the baseline %s\n", baseline_file_name));
+
+        result_is_ok = false;
+      }
+    }
+    else
+    {
+      none_regresses = compare_with_baseline(table_file, results, baseline, compiler, threshold, alpha);
+    }
+  }
+
+  // A regression is distinguished from a failure by the exit code 2.
+  return ((result_is_ok == false) ? EXIT_FAILURE : (none_regresses ? EXIT_SUCCESS : 2));
+}
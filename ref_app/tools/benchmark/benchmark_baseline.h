@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_BASELINE_2020_10_17_H_
+  #define BENCHMARK_BASELINE_2020_10_17_H_
+
+  // Benchmark baselines and the regression test of the host benchmarks.
+  // A baseline file is plain text. Lines beginning with # are comments,
+  // and each other line holds the timing samples of one kernel, keyed
+  // by the kernel, its variant (for instance the width or the order)
+  // and the compiler:
+  //   <kernel> <variant> <compiler> <median ns> <sample count> <samples ns ...>
+  // The times are in ns with fractions of ns, since the samples of
+  // the short kernels are averages over a batch of calls. The fields
+  // do not contain spaces. A new run is compared with its
+  // baseline with the one-sided Mann-Whitney U test (normal approximation
+  // with tie correction), which does not assume normally distributed
+  // times and is robust against the outliers of preempted samples.
+
+  #include <algorithm>
+  #include <cmath>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdio>
+  #include <cstring>
+  #include <string>
+  #include <utility>
+  #include <vector>
+
+  namespace benchmark
+  {
+    struct baseline_entry_type
+    {
+      std::string                kernel;
+      std::string                variant;
+      std::string                compiler;
+      double                     median;
+      std::vector<double>        samples;
+
+      bool has_key(const std::string& other_kernel,
+                   const std::string& other_variant,
+                   const std::string& other_compiler) const
+      {
+        return (   (kernel   == other_kernel)
+                && (variant  == other_variant)
+                && (compiler == other_compiler));
+      }
+    };
+
+    typedef std::vector<baseline_entry_type> baseline_type;
+
+    // The limit of the sample count of an entry. An entry with more
+    // samples is malformed, so that a corrupt count is not reserved.
+    constexpr unsigned long long baseline_sample_count_max = 10000000ULL;
+
+    inline std::string get_compiler_name()
+    {
+      char name[32U];
+
+      #if defined(__clang__)
+      static_cast<void>(std::snprintf(name, sizeof(name), "clang-%d.%d.%d", __clang_major__, __clang_minor__, __clang_patchlevel__));
+      #elif defined(__GNUC__)
+      static_cast<void>(std::snprintf(name, sizeof(name), "gcc-%d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__));
+      #elif defined(_MSC_VER)
+      static_cast<void>(std::snprintf(name, sizeof(name), "msvc-%d", _MSC_VER));
+      #else
+      static_cast<void>(std::snprintf(name, sizeof(name), "unknown"));
+      #endif
+
+      return std::string(name);
+    }
+
+    inline bool read_baseline(const char* file_name, baseline_type& baseline)
+    {
+      // Read the entries of the baseline file. A missing file
+      // is an empty baseline, and a malformed entry is an error.
+      baseline.clear();
+
+      std::FILE* baseline_file = std::fopen(file_name, "r");
+
+      if(baseline_file == nullptr)
+      {
+        return true;
+      }
+
+      bool result_is_ok = true;
+
+      char kernel[128U];
+
+      while(result_is_ok && (std::fscanf(baseline_file, "%127s", kernel) == 1))
+      {
+        if(kernel[0U] == '#')
+        {
+          int next_char;
+
+          do
+          {
+            next_char = std::fgetc(baseline_file);
+          }
+          while((next_char != '\n') && (next_char != EOF));
+
+          continue;
+        }
+
+        char variant [128U];
+        char compiler[128U];
+
+        double             median;
+        unsigned long long sample_count;
+
+        result_is_ok = (   (std::fscanf(baseline_file, "%127s %127s %lf %llu", variant, compiler, &median, &sample_count) == 4)
+                        && (sample_count <= baseline_sample_count_max));
+
+        baseline_entry_type entry;
+
+        if(result_is_ok)
+        {
+          entry.kernel   = kernel;
+          entry.variant  = variant;
+          entry.compiler = compiler;
+          entry.median   = median;
+
+          entry.samples.reserve(static_cast<std::size_t>(sample_count));
+        }
+
+        for(unsigned long long index = 0U; (result_is_ok && (index < sample_count)); ++index)
+        {
+          double sample;
+
+          result_is_ok = (std::fscanf(baseline_file, "%lf", &sample) == 1);
+
+          entry.samples.push_back(sample);
+        }
+
+        if(result_is_ok)
+        {
+          baseline.push_back(std::move(entry));
+        }
+      }
+
+      static_cast<void>(std::fclose(baseline_file));
+
+      return result_is_ok;
+    }
+
+    inline bool write_baseline(const char* file_name, const baseline_type& baseline)
+    {
+      std::FILE* baseline_file = std::fopen(file_name, "w");
+
+      if(baseline_file == nullptr)
+      {
+        return false;
+      }
+
+      static_cast<void>(std::fputs("# Benchmark baseline of tools/benchmark/benchmark_app.\n"
+                                   "# <kernel> <variant> <compiler> <median ns> <sample count> <samples ns ...>\n",
+                                   baseline_file));
+
+      for(const baseline_entry_type& entry : baseline)
+      {
+        static_cast<void>(std::fprintf(baseline_file,
+                                       "%s %s %s %.3f %llu",
+                                       entry.kernel.c_str(),
+                                       entry.variant.c_str(),
+                                       entry.compiler.c_str(),
+                                       entry.median,
+                                       static_cast<unsigned long long>(entry.samples.size())));
+
+        for(const double sample : entry.samples)
+        {
+          static_cast<void>(std::fprintf(baseline_file, " %.3f", sample));
+        }
+
+        static_cast<void>(std::fputc('\n', baseline_file));
+      }
+
+      return (std::fclose(baseline_file) == 0);
+    }
+
+    inline void update_baseline(baseline_type& baseline, baseline_entry_type&& entry)
+    {
+      // Replace the entry having the same key, or else append it.
+      auto it = std::find_if(baseline.begin(),
+                             baseline.end(),
+                             [&entry](const baseline_entry_type& other_entry)
+                             {
+                               return other_entry.has_key(entry.kernel, entry.variant, entry.compiler);
+                             });
+
+      if(it != baseline.end())
+      {
+        *it = std::move(entry);
+      }
+      else
+      {
+        baseline.push_back(std::move(entry));
+      }
+    }
+
+    // The one-sided p-values of the Mann-Whitney U test,
+    // with the alternatives that the samples are greater than
+    // (slower) or less than (faster) the baseline samples.
+    struct mann_whitney_result_type
+    {
+      double p_greater;
+      double p_less;
+    };
+
+    inline mann_whitney_result_type mann_whitney_test(const std::vector<double>& baseline_samples,
+                                                      const std::vector<double>& samples)
+    {
+      const double n_baseline = double(baseline_samples.size());
+      const double n_samples  = double(samples.size());
+      const double n_total    = n_baseline + n_samples;
+
+      // Rank the pooled samples, marking the ones of the new run.
+      std::vector<std::pair<double, bool>> pooled;
+
+      pooled.reserve(baseline_samples.size() + samples.size());
+
+      for(const double sample : baseline_samples) { pooled.emplace_back(sample, false); }
+      for(const double sample : samples)          { pooled.emplace_back(sample, true); }
+
+      std::sort(pooled.begin(), pooled.end());
+
+      double rank_sum = 0.0;
+      double tie_sum  = 0.0;
+
+      for(std::size_t first = 0U; first < pooled.size(); )
+      {
+        std::size_t last = first + 1U;
+
+        while((last < pooled.size()) && (pooled[last].first == pooled[first].first))
+        {
+          ++last;
+        }
+
+        // Tied samples get the mean of their ranks (which begin at 1).
+        const double tie_count = double(last - first);
+        const double mean_rank = (double(first + last) + 1.0) / 2.0;
+
+        for(std::size_t index = first; index < last; ++index)
+        {
+          rank_sum += (pooled[index].second ? mean_rank : 0.0);
+        }
+
+        tie_sum += ((tie_count * tie_count) - 1.0) * tie_count;
+
+        first = last;
+      }
+
+      const double u = rank_sum - ((n_samples * (n_samples + 1.0)) / 2.0);
+
+      const double u_mean     = (n_baseline * n_samples) / 2.0;
+      const double u_variance =   ((n_baseline * n_samples) / 12.0)
+                                * ((n_total + 1.0) - (tie_sum / (n_total * (n_total - 1.0))));
+
+      mann_whitney_result_type result = { 1.0, 1.0 };
+
+      if((n_baseline > 0.0) && (n_samples > 0.0) && (u_variance > 0.0))
+      {
+        using std::erfc;
+        using std::sqrt;
+
+        const double u_deviation = sqrt(u_variance);
+
+        // Use the normal approximation with the continuity correction.
+        const double z_greater = ((u - u_mean) - 0.5) / u_deviation;
+        const double z_less    = ((u_mean - u) - 0.5) / u_deviation;
+
+        result.p_greater = erfc(z_greater / sqrt(2.0)) / 2.0;
+        result.p_less    = erfc(z_less    / sqrt(2.0)) / 2.0;
+      }
+
+      return result;
+    }
+  }
+
+#endif // BENCHMARK_BASELINE_2020_10_17_H_
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Microbenchmark of the block transfers of util::communication_base.
+// It compares the transfer with one virtual send per byte
+// (the former send_n) with the block transfer of send_n
+// on a buffer, for transfers of 1, 16 and 4096 bytes
+// with the host dummy SPI and the software port SPI driver.
+// The pins of the port driver write a volatile port register
+// (with MOSI looped back to MISO), like the pins of a target.
+// The dummy SPI does no work per byte, so its rows are reported
+// as the overhead of a transfer call only, not as a throughput.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   g++ -std=c++17 -O2 -I../../src -I../../src/mcal/host benchmark_communication.cpp ../../src/mcal/host/mcal_cpu.cpp ../../src/mcal/host/mcal_gpt.cpp ../../src/mcal/host/mcal_irq.cpp -pthread -o benchmark_communication
+//   ./benchmark_communication
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <mcal_spi/mcal_spi_software_dummy.h>
+#include <mcal_spi/mcal_spi_software_port_driver.h>
+
+namespace
+{
+  // The port register of the benchmark, which the compiler
+  // can not optimize away.
+  volatile std::uint8_t port_register;
+
+  // A port pin (a bit of the port register).
+  template<const std::uint8_t bpos>
+  class port_pin_register
+  {
+  public:
+    static void init                () noexcept { }
+    static void set_direction_output() noexcept { }
+    static void set_direction_input () noexcept { }
+    static void set_pin_high        () noexcept { port_register = std::uint8_t(port_register |  std::uint8_t(1U << bpos)); }
+    static void set_pin_low         () noexcept { port_register = std::uint8_t(port_register & std::uint8_t(~std::uint8_t(1U << bpos))); }
+    static bool read_input_value    () noexcept { return (std::uint8_t(port_register & std::uint8_t(1U << bpos)) != 0U); }
+    static void toggle_pin          () noexcept { port_register = std::uint8_t(port_register ^  std::uint8_t(1U << bpos)); }
+  };
+
+  // SCK, MOSI and CSN, and MISO is looped back to MOSI.
+  typedef mcal::spi::spi_software_port_driver<port_pin_register<0U>,
+                                              port_pin_register<1U>,
+                                              port_pin_register<2U>,
+                                              port_pin_register<1U>,
+                                              0U,
+                                              false> spi_port_driver_type;
+
+  std::array<std::uint8_t, 4096U> buffer;
+
+  // The communication is accessed with a volatile pointer,
+  // so that the compiler can not devirtualize the calls.
+  util::communication_base* volatile com_dummy;
+  util::communication_base* volatile com_port_driver;
+
+  bool send_per_byte(util::communication_base& com, const std::size_t count)
+  {
+    bool send_result = true;
+
+    for(std::size_t index = 0U; index < count; ++index)
+    {
+      send_result &= com.send(buffer[index]);
+    }
+
+    return send_result;
+  }
+
+  bool send_block(util::communication_base& com, const std::size_t count)
+  {
+    return com.send_n(buffer.data(), buffer.data() + count);
+  }
+
+  template<typename transfer_function_type>
+  void benchmark_transfer(const char* name,
+                          util::communication_base* volatile& com,
+                          const std::size_t count,
+                          transfer_function_type transfer_function,
+                          const bool is_overhead_only)
+  {
+    // Transfer for about 0.2 seconds (of the steady clock).
+    std::uint64_t transfer_count = 0U;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto elapsed = std::chrono::steady_clock::duration(0);
+
+    while(elapsed < std::chrono::milliseconds(200))
+    {
+      for(unsigned index = 0U; index < 256U; ++index)
+      {
+        static_cast<void>(transfer_function(*com, count));
+      }
+
+      transfer_count += 256U;
+
+      elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+
+    const double ns_per_transfer = (seconds / double(transfer_count)) * 1.0E9;
+
+    if(is_overhead_only)
+    {
+      std::printf("%-34s %5u bytes %10.1f ns per transfer (overhead only)\n",
+                  name,
+                  unsigned(count),
+                  ns_per_transfer);
+    }
+    else
+    {
+      std::printf("%-34s %5u bytes %10.1f ns %10.2f MB/s\n",
+                  name,
+                  unsigned(count),
+                  ns_per_transfer,
+                  ((double(transfer_count) * double(count)) / seconds) / 1.0E6);
+    }
+  }
+}
+
+int main()
+{
+  static mcal::spi::spi_software_dummy the_dummy;
+  static spi_port_driver_type          the_port_driver;
+
+  com_dummy       = &the_dummy;
+  com_port_driver = &the_port_driver;
+
+  for(const std::size_t count : { std::size_t(1U), std::size_t(16U), std::size_t(4096U) })
+  {
+    benchmark_transfer("spi_software_dummy per byte",       com_dummy,       count, send_per_byte, true);
+    benchmark_transfer("spi_software_dummy block",          com_dummy,       count, send_block,    true);
+    benchmark_transfer("spi_software_port_driver per byte", com_port_driver, count, send_per_byte, false);
+    benchmark_transfer("spi_software_port_driver block",    com_port_driver, count, send_block,    false);
+  }
+}
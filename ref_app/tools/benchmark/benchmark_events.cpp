@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Stress test and benchmark of the task events with several producers.
+// Eight producer threads each send 20000 events (one event bit per
+// producer) to an event-triggered consumer task, which runs in the
+// scheduler together with a cyclic task of the configuration in
+// benchmark_events_cfg.h. Each producer sends its next event only
+// after the consumer has acknowledged the previous one, so that every
+// event must arrive: an event that is lost in a race of set_event and
+// clear_event stalls its producer, which is reported after one second.
+// The latency from set_event to the consumer task is measured, too.
+// Build and run it with both of the event access types:
+// OS_EVENT_ACCESS_TYPE=0 (critical sections) and
+// OS_EVENT_ACCESS_TYPE=1 (atomic operations).
+//
+// Build and run (from ref_app/tools/benchmark):
+//   for access in 0 1; do
+//     g++ -std=c++17 -O2 -DOS_CFG_TASK_HEADER='"benchmark_events_cfg.h"' -DOS_EVENT_ACCESS_TYPE=$access -I. -I../../src -I../../src/mcal/host -I../../src/util/STL_C++XX_stdfloat benchmark_events.cpp ../../src/os/os.cpp ../../src/os/os_task_control_block.cpp ../../src/mcal/host/mcal_cpu.cpp ../../src/mcal/host/mcal_gpt.cpp ../../src/mcal/host/mcal_irq.cpp -pthread -o benchmark_events
+//     ./benchmark_events
+//   done
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <os/os.h>
+
+namespace
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  constexpr std::size_t   producer_count = 8U;
+  constexpr std::uint32_t event_count    = UINT32_C(20000);
+
+  std::uint64_t get_time_ns()
+  {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count());
+  }
+
+  // The number of the acknowledged events and the time of the
+  // last set_event of each producer.
+  std::atomic<std::uint32_t> producer_ack_count [producer_count];
+  std::atomic<std::uint64_t> producer_event_time[producer_count];
+
+  // The statistics of the consumer task.
+  std::uint32_t consumed_count;
+  std::uint64_t latency_sum;
+  std::uint64_t latency_max;
+  std::uint64_t consumed_time;
+
+  std::uint64_t start_time;
+
+  void producer(const std::size_t producer_index)
+  {
+    const os::event_type event_bit = os::event_type(os::event_type(1U) << producer_index);
+
+    for(std::uint32_t index = 0U; index < event_count; ++index)
+    {
+      while(producer_ack_count[producer_index].load(std::memory_order_acquire) != index)
+      {
+        std::this_thread::yield();
+      }
+
+      producer_event_time[producer_index].store(get_time_ns(), std::memory_order_relaxed);
+
+      static_cast<void>(os::set_event(os::task_id_consumer, event_bit));
+    }
+  }
+
+  const char* get_event_access_name()
+  {
+    #if (OS_EVENT_ACCESS_TYPE == OS_EVENT_ACCESS_TYPE_ATOMIC)
+    return "atomic";
+    #else
+    return "critical_section";
+    #endif
+  }
+}
+
+void benchmark::events::task_init() { }
+
+void benchmark::events::consumer_task_func()
+{
+  os::event_type the_event;
+
+  os::get_event(the_event);
+
+  const std::uint64_t now = get_time_ns();
+
+  for(std::size_t producer_index = 0U; producer_index < producer_count; ++producer_index)
+  {
+    const os::event_type event_bit = os::event_type(os::event_type(1U) << producer_index);
+
+    if((the_event & event_bit) != 0U)
+    {
+      // Clear the event before the acknowledgement,
+      // since the producer sends its next event upon it.
+      os::clear_event(event_bit);
+
+      const std::uint64_t latency = now - producer_event_time[producer_index].load(std::memory_order_relaxed);
+
+      latency_sum += latency;
+      latency_max  = ((latency > latency_max) ? latency : latency_max);
+
+      ++consumed_count;
+
+      consumed_time = now;
+
+      static_cast<void>(producer_ack_count[producer_index].fetch_add(1U, std::memory_order_release));
+    }
+  }
+}
+
+void benchmark::events::cyclic_task_func() { }
+
+void sys::idle::task_init()
+{
+  start_time    = get_time_ns();
+  consumed_time = start_time;
+
+  for(std::size_t producer_index = 0U; producer_index < producer_count; ++producer_index)
+  {
+    std::thread(producer, producer_index).detach();
+  }
+}
+
+void sys::idle::task_func()
+{
+  const std::uint64_t now = get_time_ns();
+
+  if(consumed_count == std::uint32_t(producer_count * event_count))
+  {
+    std::printf("event access: %-16s events: %6u ns per event: %6.0f latency mean ns: %6.0f max ns: %8llu\n",
+                get_event_access_name(),
+                unsigned(consumed_count),
+                double(consumed_time - start_time) / double(consumed_count),
+                double(latency_sum) / double(consumed_count),
+                static_cast<unsigned long long>(latency_max));
+
+    std::exit(EXIT_SUCCESS);
+  }
+  else if((now - consumed_time) > UINT64_C(1000000000))
+  {
+    std::printf("event access: %-16s lost an event after %u of %u events\n",
+                get_event_access_name(),
+                unsigned(consumed_count),
+                unsigned(producer_count * event_count));
+
+    std::exit(EXIT_FAILURE);
+  }
+  else
+  {
+    std::this_thread::yield();
+  }
+}
+
+int main()
+{
+  os::start_os();
+}
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_EVENTS_CFG_2020_10_17_H_
+  #define BENCHMARK_EVENTS_CFG_2020_10_17_H_
+
+  // The task configuration of benchmark_events, which replaces the
+  // task configuration of os_cfg.h via OS_CFG_TASK_HEADER. It has an
+  // event-triggered consumer task and a cyclic task at 1ms, which
+  // keeps the scheduler busy with its own timer activations.
+
+  namespace benchmark
+  {
+    namespace events
+    {
+      void task_init();
+      void consumer_task_func();
+      void cyclic_task_func();
+    }
+  }
+
+  namespace os
+  {
+    typedef enum enum_task_id : std::uint_least16_t
+    {
+      task_id_consumer,
+      task_id_cyclic,
+      task_id_end
+    }
+    task_id_type;
+
+    typedef task_table<task_timing<timer_type::microseconds(UINT32_C(   0)), timer_type::microseconds(UINT32_C(10))>,
+                       task_timing<timer_type::microseconds(UINT32_C(1000)), timer_type::microseconds(UINT32_C( 1))>>
+    task_table_type;
+  }
+
+  #define OS_TASK_LIST                                                                                \
+  {                                                                                                   \
+    {                                                                                                 \
+      os::task_control_block(benchmark::events::task_init,                                            \
+                             benchmark::events::consumer_task_func,                                   \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_consumer)),        \
+                             os::tick_type(os::task_table_type::offset(os::task_id_consumer)),        \
+                             os::task_activation_event),                                              \
+      os::task_control_block(benchmark::events::task_init,                                            \
+                             benchmark::events::cyclic_task_func,                                     \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_cyclic)),          \
+                             os::tick_type(os::task_table_type::offset(os::task_id_cyclic))),         \
+    }                                                                                                 \
+  }
+
+  #define OS_TASK_AFFINITY_GROUP_COUNT 1U
+
+  #define OS_TASK_AFFINITY_GROUP_LIST { 0U, 0U }
+
+#endif // BENCHMARK_EVENTS_CFG_2020_10_17_H_
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmark of an interrupt-to-task path with the host interrupt
+// emulation. An interrupt service routine at 10kHz pushes its due
+// timestamp into an os::deferred_queue, and the task loop drains
+// the queue and measures the time from the interrupt to the task.
+// The task loop also holds critical sections of about 20us,
+// which mask the interrupt. Build with OS_EVENT_ACCESS_TYPE=0,
+// so that the deferred queue uses critical sections.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   g++ -std=c++17 -O2 -DOS_EVENT_ACCESS_TYPE=0 -I../../src -I../../src/mcal/host benchmark_irq.cpp ../../src/mcal/host/mcal_gpt.cpp ../../src/mcal/host/mcal_irq.cpp -pthread -o benchmark_irq
+//   ./benchmark_irq
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+#include <mcal_irq.h>
+#include <os/os_deferred_queue.h>
+
+namespace
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  os::deferred_queue<64U> isr_queue;
+
+  std::uint64_t get_time_ns()
+  {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count());
+  }
+
+  std::uint32_t isr_overflow_count;
+
+  std::uint64_t isr_to_task_count;
+  std::uint64_t isr_to_task_sum;
+  std::uint64_t isr_to_task_max;
+
+  void isr_to_task(const std::uintptr_t payload)
+  {
+    const std::uint64_t latency = get_time_ns() - std::uint64_t(payload);
+
+    isr_to_task_sum += latency;
+    isr_to_task_max  = ((latency > isr_to_task_max) ? latency : isr_to_task_max);
+
+    ++isr_to_task_count;
+  }
+
+  void isr_timer()
+  {
+    if(isr_queue.push(isr_to_task, std::uintptr_t(get_time_ns())) == false)
+    {
+      ++isr_overflow_count;
+    }
+  }
+}
+
+int main()
+{
+  std::size_t isr_index;
+
+  if(mcal::irq::register_isr(isr_timer, 100U, isr_index) == false)
+  {
+    std::printf("the interrupt emulation is not available\n");
+
+    return 1;
+  }
+
+  const clock_type::time_point start = clock_type::now();
+
+  volatile std::uint32_t shared_counter = 0U;
+
+  while(clock_type::now() - start < std::chrono::seconds(2))
+  {
+    isr_queue.drain();
+
+    // Hold a critical section of about 20us.
+    mcal::irq::disable_all();
+
+    const clock_type::time_point critical_section_end = clock_type::now() + std::chrono::microseconds(20);
+
+    while(clock_type::now() < critical_section_end)
+    {
+      shared_counter = shared_counter + 1U;
+    }
+
+    mcal::irq::enable_all();
+
+    // Run with the interrupts enabled for about 80us.
+    const clock_type::time_point task_end = clock_type::now() + std::chrono::microseconds(80);
+
+    while(clock_type::now() < task_end)
+    {
+      isr_queue.drain();
+    }
+  }
+
+  mcal::irq::isr_statistics_type statistics;
+
+  mcal::irq::get_isr_statistics(isr_index, statistics);
+
+  std::printf("interrupts          : %lu (%lu masked)\n",
+              static_cast<unsigned long>(statistics.call_count),
+              static_cast<unsigned long>(statistics.masked_count));
+
+  std::printf("interrupt latency   : min/mean/max %llu/%llu/%llu ns\n",
+              static_cast<unsigned long long>(statistics.latency_min),
+              static_cast<unsigned long long>(statistics.latency_mean),
+              static_cast<unsigned long long>(statistics.latency_max));
+
+  std::printf("interrupt to task   : mean/max %llu/%llu ns (%llu items, %lu overflows)\n",
+              static_cast<unsigned long long>((isr_to_task_count != 0U) ? (isr_to_task_sum / isr_to_task_count) : 0U),
+              static_cast<unsigned long long>(isr_to_task_max),
+              static_cast<unsigned long long>(isr_to_task_count),
+              static_cast<unsigned long>(isr_overflow_count));
+
+  std::printf("lock contention     : %lu\n",
+              static_cast<unsigned long>(mcal::irq::get_lock_contention_count()));
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Microbenchmark of the system tick reads of the host mcal_gpt.
+// It compares the former read (a yield on each read, a sleep of 3ms
+// on every 8192nd read, and a high_resolution_clock duration_cast)
+// with the read of the monotonic clock of the host mcal_gpt.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   g++ -std=c++17 -O2 -I../../src -I../../src/mcal/host benchmark_mcal_gpt.cpp ../../src/mcal/host/mcal_gpt.cpp -pthread -o benchmark_mcal_gpt
+//   ./benchmark_mcal_gpt
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include <mcal_gpt.h>
+#include <util/utility/util_time.h>
+
+namespace
+{
+  typedef util::timer<mcal::gpt::value_type> timer_type;
+
+  std::uint64_t former_get_time_elapsed()
+  {
+    static const std::chrono::high_resolution_clock::time_point init =
+      std::chrono::high_resolution_clock::now();
+
+    static std::uint_fast16_t sleep_prescaler;
+
+    ++sleep_prescaler;
+
+    if((sleep_prescaler % UINT16_C(8192)) == 0U)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(3U));
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+
+    const std::chrono::microseconds duration_in_microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>
+        (std::chrono::high_resolution_clock::now() - init);
+
+    return static_cast<std::uint64_t>(duration_in_microseconds.count());
+  }
+
+  template<typename read_function_type>
+  void benchmark_reads(const char* name, read_function_type read_function)
+  {
+    // Read the tick for about one second (of the steady clock).
+    volatile std::uint64_t sink = 0U;
+
+    std::uint64_t read_count = 0U;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto elapsed = std::chrono::steady_clock::duration(0);
+
+    while(elapsed < std::chrono::seconds(1))
+    {
+      for(unsigned index = 0U; index < 1024U; ++index)
+      {
+        sink = read_function();
+      }
+
+      read_count += 1024U;
+
+      elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+    static_cast<void>(sink);
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::printf("%-28s %12.0f reads/s %10.1f ns/read\n",
+                name,
+                double(read_count) / seconds,
+                (seconds * 1.0E9) / double(read_count));
+  }
+}
+
+int main()
+{
+  benchmark_reads("former (yield/sleep)", former_get_time_elapsed);
+  benchmark_reads("mcal_gpt (monotonic clock)", []() { return timer_type::get_mark(); });
+}
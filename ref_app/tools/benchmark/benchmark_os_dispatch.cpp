@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmark of the dispatch overhead of the scheduler for a growing
+// number of tasks. The task set of benchmark_os_dispatch_cfg.h
+// replaces the task configuration of os_cfg.h. The tasks and the idle
+// task do nothing but read the clock when they begin and when they end.
+// The time from the end of one of them to the beginning of the next one
+// is the time which the scheduler spent in between. It is summed up
+// separately for the passes that dispatch a task and for the passes
+// that call the idle task, since there are far more of the latter.
+// After two seconds, the median scheduler time per dispatch (which is
+// robust against the few dispatches that the host preempts) and the mean
+// time per idle pass are printed, both less the cost of one clock read,
+// together with the numbers of the task dispatches and of the idle passes. Compare the
+// linear scheduler with the ready queue at 3, 32 and 256 tasks.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   for tasks in 3 32 256; do
+//     for scheduler in OS_SCHEDULER_TYPE_LINEAR OS_SCHEDULER_TYPE_READY_QUEUE; do
+//       g++ -std=c++17 -O2 -DOS_CFG_TASK_HEADER='"benchmark_os_dispatch_cfg.h"' -DBENCHMARK_OS_TASK_COUNT=$tasks -DOS_SCHEDULER_TYPE=$scheduler -I. -I../../src -I../../src/mcal/host -I../../src/util/STL_C++XX_stdfloat benchmark_os_dispatch.cpp ../../src/os/os.cpp ../../src/os/os_task_control_block.cpp ../../src/mcal/host/mcal_gpt.cpp ../../src/mcal/host/mcal_cpu.cpp -pthread -o benchmark_os_dispatch
+//       ./benchmark_os_dispatch
+//     done
+//   done
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <os/os.h>
+#include <os/os_task_control_block.h>
+
+namespace
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  clock_type::time_point benchmark_start;
+  clock_type::time_point pass_end;
+
+  clock_type::duration clock_read_time;
+  std::vector<clock_type::duration> dispatch_times;
+  clock_type::duration              idle_time;
+
+  std::uint64_t dispatch_count;
+  std::uint64_t idle_count;
+
+  clock_type::duration get_clock_read_time()
+  {
+    // The least time between two clock reads.
+    clock_type::duration read_time = clock_type::duration::max();
+
+    for(unsigned index = 0U; index < 1000U; ++index)
+    {
+      const clock_type::time_point first  = clock_type::now();
+      const clock_type::time_point second = clock_type::now();
+
+      read_time = (std::min)(read_time, clock_type::duration(second - first));
+    }
+
+    return read_time;
+  }
+
+  double get_ns(const clock_type::duration time)
+  {
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(time - clock_read_time).count());
+  }
+
+  double get_median_ns(std::vector<clock_type::duration>& times)
+  {
+    if(times.empty())
+    {
+      return 0.0;
+    }
+
+    std::nth_element(times.begin(), times.begin() + (times.size() / 2U), times.end());
+
+    return get_ns(times[times.size() / 2U]);
+  }
+
+  double get_mean_ns(const clock_type::duration total, const std::uint64_t count)
+  {
+    return ((count != 0U) ? get_ns(total / count) : 0.0);
+  }
+}
+
+void benchmark::os_dispatch::task_init() { }
+
+void benchmark::os_dispatch::task_func()
+{
+  dispatch_times.push_back(clock_type::now() - pass_end);
+
+  ++dispatch_count;
+
+  pass_end = clock_type::now();
+}
+
+void sys::idle::task_init()
+{
+  clock_read_time = get_clock_read_time();
+
+  // Reserve the dispatches of the run, so that they are not reallocated.
+  dispatch_times.reserve(std::size_t(BENCHMARK_OS_TASK_COUNT) * 2048U);
+
+  benchmark_start = clock_type::now();
+  pass_end        = benchmark_start;
+}
+
+void sys::idle::task_func()
+{
+  const clock_type::time_point pass_begin = clock_type::now();
+
+  idle_time += (pass_begin - pass_end);
+
+  ++idle_count;
+
+  if((pass_begin - benchmark_start) > std::chrono::seconds(2))
+  {
+    std::printf("scheduler: %-16s tasks: %3u dispatches: %8llu idle passes: %10llu ns per dispatch: %6.1f ns per idle pass: %6.1f\n",
+                benchmark::os_dispatch::get_scheduler_name(),
+                unsigned(BENCHMARK_OS_TASK_COUNT),
+                static_cast<unsigned long long>(dispatch_count),
+                static_cast<unsigned long long>(idle_count),
+                get_median_ns(dispatch_times),
+                get_mean_ns(idle_time,     idle_count));
+
+    std::exit(EXIT_SUCCESS);
+  }
+
+  pass_end = clock_type::now();
+}
+
+int main()
+{
+  os::start_os();
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_OS_DISPATCH_CFG_2020_10_17_H_
+  #define BENCHMARK_OS_DISPATCH_CFG_2020_10_17_H_
+
+  // The synthetic task configuration of benchmark_os_dispatch, which
+  // replaces the task configuration of os_cfg.h via OS_CFG_TASK_HEADER.
+  // It has BENCHMARK_OS_TASK_COUNT cyclic tasks, whose cycles are
+  // 1ms, 2ms and 4ms in turn (keeping the hyperperiod at 4ms)
+  // with a budget of 1us each. All of the tasks share one task
+  // function. The affinity groups are not configured, since
+  // they are only needed by the multithreaded scheduler.
+  // The task list and the scheduler name are shared by the
+  // benchmarks benchmark_os_dispatch and benchmark_os_virtual_time.
+
+  #include <array>
+  #include <cstddef>
+
+  #if !defined(BENCHMARK_OS_TASK_COUNT)
+  #define BENCHMARK_OS_TASK_COUNT 32U
+  #endif
+
+  namespace benchmark
+  {
+    namespace os_dispatch
+    {
+      void task_init();
+      void task_func();
+
+      inline const char* get_scheduler_name()
+      {
+        #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_LINEAR)
+        return "linear";
+        #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+        return "ready_queue";
+        #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE)
+        return "cyclic_executive";
+        #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_EDF)
+        return "edf";
+        #else
+        return "other";
+        #endif
+      }
+
+      template<typename index_list_type>
+      struct make_task_table;
+
+      template<std::size_t... indices>
+      struct make_task_table<os::detail::index_list<indices...>>
+      {
+        typedef os::task_table<os::task_timing<os::timer_type::microseconds(UINT32_C(1000) << (indices % 3U)),
+                                               os::timer_type::microseconds(UINT32_C(1))>...>
+        type;
+      };
+    }
+  }
+
+  namespace os
+  {
+    typedef enum enum_task_id : std::uint_least16_t
+    {
+      task_id_end = BENCHMARK_OS_TASK_COUNT
+    }
+    task_id_type;
+
+    typedef benchmark::os_dispatch::make_task_table<detail::make_index_list<BENCHMARK_OS_TASK_COUNT>::type>::type
+    task_table_type;
+  }
+
+  namespace benchmark
+  {
+    namespace os_dispatch
+    {
+      // The task control block is a template parameter, since it is
+      // not yet complete here (this header is included by os_cfg.h).
+      template<typename task_control_block_type, std::size_t... indices>
+      std::array<task_control_block_type, BENCHMARK_OS_TASK_COUNT> make_task_list(os::detail::index_list<indices...>)
+      {
+        return
+        {
+          {
+            task_control_block_type(task_init,
+                                    task_func,
+                                    os::tick_type(os::task_table_type::cycle (indices)),
+                                    os::tick_type(os::task_table_type::offset(indices)))...
+          }
+        };
+      }
+    }
+  }
+
+  #define OS_TASK_LIST benchmark::os_dispatch::make_task_list<os::task_control_block>(os::detail::make_index_list<BENCHMARK_OS_TASK_COUNT>::type())
+
+#endif // BENCHMARK_OS_DISPATCH_CFG_2020_10_17_H_
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmark of the deadline misses of the fixed-priority schedulers
+// (the order of the task list) and of EDF under a growing load.
+// The tasks of benchmark_os_overload_cfg.h (10ms, 4ms and 2ms) spin
+// for the run times that are given on the command line (in
+// microseconds, default 2000 1000 500, a utilization of 70 percent).
+// After 500 cycles of the 10ms task (5s), the deadline misses and the
+// activations of each task are printed from the task statistics.
+// For instance, the run times 3000 1500 700 make a utilization of
+// 102.5 percent, and 2500 1200 600 one of 85 percent.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   for scheduler in OS_SCHEDULER_TYPE_LINEAR OS_SCHEDULER_TYPE_READY_QUEUE OS_SCHEDULER_TYPE_EDF; do
+//     g++ -std=c++17 -O2 -DOS_TASK_PROFILING=1 -DOS_CFG_TASK_HEADER='"benchmark_os_overload_cfg.h"' -DOS_SCHEDULER_TYPE=$scheduler -I. -I../../src -I../../src/mcal/host -I../../src/util/STL_C++XX_stdfloat benchmark_os_overload.cpp ../../src/os/os.cpp ../../src/os/os_task_control_block.cpp ../../src/mcal/host/mcal_gpt.cpp ../../src/mcal/host/mcal_cpu.cpp -pthread -o benchmark_os_overload
+//     ./benchmark_os_overload 2500 1200 600
+//   done
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <mcal_cpu.h>
+#include <os/os.h>
+
+#if (OS_TASK_PROFILING != 1)
+#error benchmark_os_overload requires OS_TASK_PROFILING=1
+#endif
+
+namespace
+{
+  constexpr std::uint32_t cycle_count_max = UINT32_C(500);
+
+  std::uint32_t run_microseconds[3U] = { UINT32_C(2000), UINT32_C(1000), UINT32_C(500) };
+
+  std::uint32_t cycle_count;
+
+  const char* get_scheduler_name()
+  {
+    #if (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_LINEAR)
+    return "linear";
+    #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_READY_QUEUE)
+    return "ready_queue";
+    #elif (OS_SCHEDULER_TYPE == OS_SCHEDULER_TYPE_EDF)
+    return "edf";
+    #else
+    return "other";
+    #endif
+  }
+
+  void spin(const std::uint32_t microseconds)
+  {
+    const os::timer_type run_timer(os::timer_type::microseconds(microseconds));
+
+    while(run_timer.timeout() == false)
+    {
+      ;
+    }
+  }
+
+  void print_statistics()
+  {
+    const std::uint32_t utilization_permille =
+        ((run_microseconds[0U] * 1000U) / 10000U)
+      + ((run_microseconds[1U] * 1000U) /  4000U)
+      + ((run_microseconds[2U] * 1000U) /  2000U);
+
+    std::printf("scheduler: %-12s utilization: %4lu permille",
+                get_scheduler_name(),
+                static_cast<unsigned long>(utilization_permille));
+
+    unsigned long miss_count_total       = 0U;
+    unsigned long activation_count_total = 0U;
+
+    for(std::size_t index = 0U; index < std::size_t(os::task_id_end); ++index)
+    {
+      os::task_statistics statistics;
+
+      os::get_task_statistics(os::task_id_type(index), statistics);
+
+      std::printf("  task %u: %lu/%lu",
+                  unsigned(index),
+                  static_cast<unsigned long>(statistics.deadline_miss_count),
+                  static_cast<unsigned long>(statistics.activation_count));
+
+      miss_count_total       += static_cast<unsigned long>(statistics.deadline_miss_count);
+      activation_count_total += static_cast<unsigned long>(statistics.activation_count);
+    }
+
+    std::printf("  misses: %lu of %lu (%.1f%%)\n",
+                miss_count_total,
+                activation_count_total,
+                (100.0 * double(miss_count_total)) / double(activation_count_total));
+  }
+}
+
+void benchmark::os_overload::task_init() { }
+
+void benchmark::os_overload::task_func_10ms()
+{
+  spin(run_microseconds[0U]);
+
+  ++cycle_count;
+
+  if(cycle_count == cycle_count_max)
+  {
+    print_statistics();
+
+    std::exit(EXIT_SUCCESS);
+  }
+}
+
+void benchmark::os_overload::task_func_4ms() { spin(run_microseconds[1U]); }
+void benchmark::os_overload::task_func_2ms() { spin(run_microseconds[2U]); }
+
+void sys::idle::task_init() { }
+
+void sys::idle::task_func()
+{
+  const os::tick_type wait_ticks = os::get_ticks_until_next_task();
+
+  if(wait_ticks != os::tick_type(0U))
+  {
+    mcal::cpu::wait_for_wakeup(static_cast<std::uint32_t>(wait_ticks / os::timer_type::microseconds(1U)));
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  for(int index = 1; ((index < argc) && (index <= 3)); ++index)
+  {
+    run_microseconds[index - 1] = static_cast<std::uint32_t>(std::strtoul(argv[index], nullptr, 10));
+  }
+
+  os::start_os();
+}
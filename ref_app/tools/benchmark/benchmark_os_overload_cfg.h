@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_OS_OVERLOAD_CFG_2020_10_17_H_
+  #define BENCHMARK_OS_OVERLOAD_CFG_2020_10_17_H_
+
+  // The task configuration of benchmark_os_overload, which replaces
+  // the task configuration of os_cfg.h via OS_CFG_TASK_HEADER.
+  // The three cyclic tasks have the cycles 10ms, 4ms and 2ms in this
+  // order, so that the priority of the task list is the reverse
+  // of the rate-monotonic priority. The declared budgets are small,
+  // and the benchmark sets the actual run times of the tasks.
+
+  namespace benchmark
+  {
+    namespace os_overload
+    {
+      void task_init();
+      void task_func_10ms();
+      void task_func_4ms();
+      void task_func_2ms();
+    }
+  }
+
+  namespace os
+  {
+    typedef enum enum_task_id : std::uint_least16_t
+    {
+      task_id_10ms,
+      task_id_4ms,
+      task_id_2ms,
+      task_id_end
+    }
+    task_id_type;
+
+    typedef task_table<task_timing<timer_type::microseconds(UINT32_C(10000)), timer_type::microseconds(UINT32_C(100))>,
+                       task_timing<timer_type::microseconds(UINT32_C( 4000)), timer_type::microseconds(UINT32_C(100))>,
+                       task_timing<timer_type::microseconds(UINT32_C( 2000)), timer_type::microseconds(UINT32_C(100))>>
+    task_table_type;
+  }
+
+  #define OS_TASK_LIST                                                                                \
+  {                                                                                                   \
+    {                                                                                                 \
+      os::task_control_block(benchmark::os_overload::task_init,                                       \
+                             benchmark::os_overload::task_func_10ms,                                  \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_10ms)),            \
+                             os::tick_type(os::task_table_type::offset(os::task_id_10ms))),           \
+      os::task_control_block(benchmark::os_overload::task_init,                                       \
+                             benchmark::os_overload::task_func_4ms,                                   \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_4ms)),             \
+                             os::tick_type(os::task_table_type::offset(os::task_id_4ms))),            \
+      os::task_control_block(benchmark::os_overload::task_init,                                       \
+                             benchmark::os_overload::task_func_2ms,                                   \
+                             os::tick_type(os::task_table_type::cycle (os::task_id_2ms)),             \
+                             os::tick_type(os::task_table_type::offset(os::task_id_2ms))),            \
+    }                                                                                                 \
+  }
+
+#endif // BENCHMARK_OS_OVERLOAD_CFG_2020_10_17_H_
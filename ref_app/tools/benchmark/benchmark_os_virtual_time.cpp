@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmark of the cost of one task dispatch in the virtual time
+// (MCAL_GPT_VIRTUAL_TIME=1), where the idle task jumps over the time
+// until the next task instead of waiting. So the run measures only
+// the scheduler: the cyclic executive with its compile-time schedule
+// of minor frames, compared with the timer-driven loops of start_os
+// (the linear scheduler, the ready queue and EDF). The task set is
+// the one of benchmark_os_dispatch_cfg.h. After 2000000 dispatches,
+// the mean wall-clock time of one dispatch is printed.
+//
+// Build and run (from ref_app/tools/benchmark):
+//   for scheduler in OS_SCHEDULER_TYPE_LINEAR OS_SCHEDULER_TYPE_READY_QUEUE OS_SCHEDULER_TYPE_EDF OS_SCHEDULER_TYPE_CYCLIC_EXECUTIVE; do
+//     g++ -std=c++17 -O2 -DMCAL_GPT_VIRTUAL_TIME=1 -DOS_CFG_TASK_HEADER='"benchmark_os_dispatch_cfg.h"' -DBENCHMARK_OS_TASK_COUNT=3 -DOS_SCHEDULER_TYPE=$scheduler -I. -I../../src -I../../src/mcal/host -I../../src/util/STL_C++XX_stdfloat benchmark_os_virtual_time.cpp ../../src/os/os.cpp ../../src/os/os_task_control_block.cpp ../../src/mcal/host/mcal_gpt.cpp ../../src/mcal/host/mcal_cpu.cpp -pthread -o benchmark_os_virtual_time
+//     ./benchmark_os_virtual_time
+//   done
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <mcal_cpu.h>
+#include <os/os.h>
+#include <os/os_task_control_block.h>
+
+#if (MCAL_GPT_VIRTUAL_TIME != 1)
+#error benchmark_os_virtual_time requires MCAL_GPT_VIRTUAL_TIME=1
+#endif
+
+namespace
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  constexpr std::uint32_t dispatch_count_max = UINT32_C(2000000);
+
+  clock_type::time_point benchmark_start;
+
+  std::uint32_t dispatch_count;
+}
+
+void benchmark::os_dispatch::task_init() { }
+
+void benchmark::os_dispatch::task_func()
+{
+  ++dispatch_count;
+
+  if(dispatch_count == dispatch_count_max)
+  {
+    const double elapsed_ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - benchmark_start).count());
+
+    std::printf("scheduler: %-16s tasks: %3u dispatches: %8lu ns per dispatch: %6.1f\n",
+                benchmark::os_dispatch::get_scheduler_name(),
+                unsigned(BENCHMARK_OS_TASK_COUNT),
+                static_cast<unsigned long>(dispatch_count),
+                elapsed_ns / double(dispatch_count));
+
+    std::exit(EXIT_SUCCESS);
+  }
+}
+
+void sys::idle::task_init()
+{
+  benchmark_start = clock_type::now();
+}
+
+void sys::idle::task_func()
+{
+  // Jump over the virtual time until the next task.
+  const os::tick_type wait_ticks = os::get_ticks_until_next_task();
+
+  if(wait_ticks != os::tick_type(0U))
+  {
+    mcal::cpu::wait_for_wakeup(static_cast<std::uint32_t>(wait_ticks / os::timer_type::microseconds(1U)));
+  }
+}
+
+int main()
+{
+  os::start_os();
+}
@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_PERF_COUNTERS_2020_10_17_H_
+  #define BENCHMARK_PERF_COUNTERS_2020_10_17_H_
+
+  // Hardware performance counters of the calling thread for the host
+  // benchmarks, with perf_event_open on Linux. Only the user space
+  // is counted, so that a perf_event_paranoid of 2 suffices.
+  // The counters are opened as one group with the cycles as the leader,
+  // so that they are scheduled together and count the same instructions,
+  // and they are read at once with PERF_FORMAT_GROUP. A member which is
+  // unavailable (for instance on a CPU without the cache event) only
+  // drops this counter. If the group cannot be opened, each counter
+  // is opened on its own instead. The counts are scaled when the kernel
+  // multiplexes the counters.
+  // On other systems, all of the counters are unavailable.
+
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstring>
+
+  #if defined(__linux__)
+  #include <cerrno>
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #endif
+
+  namespace benchmark
+  {
+    class perf_counters final
+    {
+    public:
+      typedef enum enum_counter_type
+      {
+        counter_cycles,
+        counter_instructions,
+        counter_branch_misses,
+        counter_l1d_misses,
+        counter_llc_misses,
+        counter_count
+      }
+      counter_type;
+
+      struct values_type
+      {
+        bool          is_valid[counter_count];
+        std::uint64_t value   [counter_count];
+      };
+
+      static const char* get_name(const counter_type counter)
+      {
+        const char* const names[counter_count] =
+        {
+          "cycles",
+          "instructions",
+          "branch_misses",
+          "l1d_misses",
+          "llc_misses"
+        };
+
+        return names[counter];
+      }
+
+      perf_counters() : my_fd(), my_error(0), my_is_group(false)
+      {
+        #if defined(__linux__)
+        // Open the group with the cycles as the leader.
+        my_fd[counter_cycles] = open_counter(counter_cycles, -1, true);
+
+        my_is_group = (my_fd[counter_cycles] != -1);
+
+        for(std::size_t index = 1U; index < std::size_t(counter_count); ++index)
+        {
+          my_fd[index] = (my_is_group ? open_counter(static_cast<counter_type>(index), my_fd[counter_cycles], true) : -1);
+        }
+
+        if(my_is_group == false)
+        {
+          // Open the counters on their own.
+          for(std::size_t index = 0U; index < std::size_t(counter_count); ++index)
+          {
+            my_fd[index] = open_counter(static_cast<counter_type>(index), -1, false);
+          }
+        }
+        #else
+        for(int& fd : my_fd)
+        {
+          fd = -1;
+        }
+        #endif
+      }
+
+      ~perf_counters()
+      {
+        #if defined(__linux__)
+        // Close the members of the group before its leader.
+        for(std::size_t index = std::size_t(counter_count); index > 0U; --index)
+        {
+          if(my_fd[index - 1U] != -1)
+          {
+            static_cast<void>(::close(my_fd[index - 1U]));
+          }
+        }
+        #endif
+      }
+
+      bool is_available() const
+      {
+        bool one_is_available = false;
+
+        for(const int fd : my_fd)
+        {
+          one_is_available |= (fd != -1);
+        }
+
+        return one_is_available;
+      }
+
+      // The error of the first counter that could not be opened (or 0).
+      int get_error() const { return my_error; }
+
+      void start()
+      {
+        #if defined(__linux__)
+        if(my_is_group)
+        {
+          static_cast<void>(::ioctl(my_fd[counter_cycles], PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP));
+          static_cast<void>(::ioctl(my_fd[counter_cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP));
+        }
+        else
+        {
+          for(const int fd : my_fd)
+          {
+            if(fd != -1)
+            {
+              static_cast<void>(::ioctl(fd, PERF_EVENT_IOC_RESET,  0));
+              static_cast<void>(::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0));
+            }
+          }
+        }
+        #endif
+      }
+
+      void stop(values_type& values)
+      {
+        for(std::size_t index = 0U; index < std::size_t(counter_count); ++index)
+        {
+          values.is_valid[index] = false;
+          values.value   [index] = 0U;
+        }
+
+        #if defined(__linux__)
+        if(my_is_group)
+        {
+          static_cast<void>(::ioctl(my_fd[counter_cycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP));
+
+          // The number of counters, the time enabled, the time running,
+          // and the counts of the leader and of the members in the order
+          // in which they were opened.
+          std::uint64_t data[3U + std::size_t(counter_count)];
+
+          const ssize_t size = ::read(my_fd[counter_cycles], data, sizeof(data));
+
+          if((size >= static_cast<ssize_t>(3U * sizeof(std::uint64_t))) && (data[2U] != 0U))
+          {
+            const std::size_t data_count = std::size_t(size) / sizeof(std::uint64_t);
+
+            std::size_t data_index = 3U;
+
+            for(std::size_t index = 0U; index < std::size_t(counter_count); ++index)
+            {
+              if((my_fd[index] != -1) && (data_index < data_count))
+              {
+                values.is_valid[index] = true;
+                values.value   [index] = scale(data[data_index], data[1U], data[2U]);
+
+                ++data_index;
+              }
+            }
+          }
+        }
+        else
+        {
+          for(std::size_t index = 0U; index < std::size_t(counter_count); ++index)
+          {
+            if(my_fd[index] != -1)
+            {
+              static_cast<void>(::ioctl(my_fd[index], PERF_EVENT_IOC_DISABLE, 0));
+
+              // The count, the time enabled and the time running.
+              std::uint64_t data[3U];
+
+              if(   (::read(my_fd[index], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)))
+                 && (data[2U] != 0U))
+              {
+                values.is_valid[index] = true;
+                values.value   [index] = scale(data[0U], data[1U], data[2U]);
+              }
+            }
+          }
+        }
+        #endif
+      }
+
+    private:
+      int  my_fd[counter_count];
+      int  my_error;
+      bool my_is_group;
+
+      #if defined(__linux__)
+      static std::uint64_t scale(const std::uint64_t count,
+                                 const std::uint64_t time_enabled,
+                                 const std::uint64_t time_running)
+      {
+        // Extrapolate the count of a multiplexed counter
+        // to the whole time that it was enabled.
+        return ((time_running == time_enabled)
+                 ? count
+                 : static_cast<std::uint64_t>((double(count) * double(time_enabled)) / double(time_running)));
+      }
+
+      int open_counter(const counter_type counter, const int group_fd, const bool is_group)
+      {
+        const std::uint64_t l1d_read_miss =
+            std::uint64_t(PERF_COUNT_HW_CACHE_L1D)
+          | std::uint64_t(std::uint64_t(PERF_COUNT_HW_CACHE_OP_READ)     <<  8U)
+          | std::uint64_t(std::uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16U);
+
+        const std::uint32_t types[counter_count] =
+        {
+          PERF_TYPE_HARDWARE,
+          PERF_TYPE_HARDWARE,
+          PERF_TYPE_HARDWARE,
+          PERF_TYPE_HW_CACHE,
+          PERF_TYPE_HARDWARE
+        };
+
+        const std::uint64_t configs[counter_count] =
+        {
+          PERF_COUNT_HW_CPU_CYCLES,
+          PERF_COUNT_HW_INSTRUCTIONS,
+          PERF_COUNT_HW_BRANCH_MISSES,
+          l1d_read_miss,
+          PERF_COUNT_HW_CACHE_MISSES
+        };
+
+        ::perf_event_attr attributes;
+
+        std::memset(&attributes, 0, sizeof(attributes));
+
+        attributes.size           = sizeof(attributes);
+        attributes.type           = types  [counter];
+        attributes.config         = configs[counter];
+        attributes.exclude_kernel = 1U;
+        attributes.exclude_hv     = 1U;
+        attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // The leader (and each counter on its own) is opened disabled.
+        // The members of the group count whenever their leader does.
+        attributes.disabled = ((group_fd == -1) ? 1U : 0U);
+
+        if(is_group)
+        {
+          attributes.read_format |= PERF_FORMAT_GROUP;
+        }
+
+        const long fd = ::syscall(SYS_perf_event_open, &attributes, 0, -1, group_fd, 0UL);
+
+        if((fd == -1L) && (my_error == 0))
+        {
+          my_error = errno;
+        }
+
+        return static_cast<int>(fd);
+      }
+      #endif
+
+      perf_counters(const perf_counters&) = delete;
+      perf_counters& operator=(const perf_counters&) = delete;
+    };
+  }
+
+#endif // BENCHMARK_PERF_COUNTERS_2020_10_17_H_